@@ -0,0 +1,72 @@
+#include <algorithms/channelizer.h>
+#include <algorithms/decimator.h>
+#include <algorithms/nco.h>
+#include <benchmark/benchmark.h>
+#include <config.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+constexpr Frequency CHANNELIZER_SAMPLE_RATE = 2048000;
+constexpr uint32_t CHANNELIZER_SAMPLES = 131072;
+constexpr uint32_t CHANNELIZER_DECIMATION = 32;
+
+// one shift and decimator per recording over the full band, as every recorder worker did before the channelizer
+void RecordingsNcoDecimator(benchmark::State& state) {
+  const Config config("", "{}");
+  const auto channels = state.range(0);
+  std::vector<std::complex<float>> input(CHANNELIZER_SAMPLES, 0.5f);
+  std::vector<std::complex<float>> shifted(CHANNELIZER_SAMPLES);
+  std::vector<std::complex<float>> output(CHANNELIZER_SAMPLES / CHANNELIZER_DECIMATION);
+  std::vector<std::unique_ptr<Nco>> ncos;
+  std::vector<std::unique_ptr<Decimator>> decimators;
+  for (int i = 0; i < channels; ++i) {
+    ncos.push_back(std::make_unique<Nco>(10000 * (i + 1), CHANNELIZER_SAMPLE_RATE));
+    decimators.push_back(std::make_unique<Decimator>(CHANNELIZER_DECIMATION));
+  }
+  for (auto _ : state) {
+    for (int i = 0; i < channels; ++i) {
+      ncos[i]->mix(input.data(), shifted.data(), CHANNELIZER_SAMPLES);
+      decimators[i]->decimate(shifted.data(), output.size(), output.data());
+    }
+    benchmark::DoNotOptimize(output.data());
+  }
+  state.SetItemsProcessed(state.iterations() * CHANNELIZER_SAMPLES);
+}
+BENCHMARK(RecordingsNcoDecimator)->Arg(1)->Arg(4)->Arg(16)->Arg(64);
+
+// shared channelizer followed by the per recording shift and decimation at the channel rate
+void RecordingsChannelizer(benchmark::State& state, const std::string& name) {
+  const Config config("", R"({"recording": {"channelizer": ")" + name + R"("}})");
+  const auto channels = state.range(0);
+  auto channelizer = createChannelizer(config, CHANNELIZER_SAMPLE_RATE, CHANNELIZER_DECIMATION);
+  const auto workerDecimation = channelizer->workerDecimation();
+  std::vector<std::complex<float>> input(CHANNELIZER_SAMPLES, 0.5f);
+  // leftover samples of the previous chunk may add up to one more block of output
+  const auto maxOutputSize = channelizer->outputSize(CHANNELIZER_SAMPLES) + CHANNELIZER_SAMPLES / CHANNELIZER_DECIMATION;
+  std::vector<std::vector<std::complex<float>>> buffers(channels, std::vector<std::complex<float>>(maxOutputSize));
+  std::vector<std::complex<float>> output(maxOutputSize);
+  std::vector<uint32_t> indexes;
+  std::vector<std::complex<float>*> outputs;
+  std::vector<std::unique_ptr<Nco>> ncos;
+  std::vector<std::unique_ptr<Decimator>> decimators;
+  for (int i = 0; i < channels; ++i) {
+    indexes.push_back(channelizer->channel(10000 * (i + 1)).index);
+    outputs.push_back(buffers[i].data());
+    ncos.push_back(std::make_unique<Nco>(1000, channelizer->outputSampleRate()));
+    decimators.push_back(std::make_unique<Decimator>(workerDecimation));
+  }
+  for (auto _ : state) {
+    const auto size = channelizer->outputSize(CHANNELIZER_SAMPLES);
+    channelizer->process(input.data(), CHANNELIZER_SAMPLES, indexes, outputs);
+    for (int i = 0; i < channels; ++i) {
+      ncos[i]->mix(outputs[i], size);
+      decimators[i]->decimate(outputs[i], size / workerDecimation, output.data());
+    }
+    benchmark::DoNotOptimize(output.data());
+  }
+  state.SetItemsProcessed(state.iterations() * CHANNELIZER_SAMPLES);
+}
+BENCHMARK_CAPTURE(RecordingsChannelizer, polyphase, std::string("polyphase"))->Arg(1)->Arg(4)->Arg(16)->Arg(64);
+BENCHMARK_CAPTURE(RecordingsChannelizer, overlap_save, std::string("overlap_save"))->Arg(1)->Arg(4)->Arg(16)->Arg(64);
@@ -0,0 +1,48 @@
+#include <benchmark/benchmark.h>
+#include <simd/decibels.h>
+
+#include <cmath>
+#include <vector>
+
+std::vector<float> decibelsInput(uint32_t size) {
+  std::vector<float> input(size);
+  for (uint32_t i = 0; i < size; ++i) {
+    input[i] = 1e-6f * (1 + i % 1000);
+  }
+  return input;
+}
+
+void DecibelsLog10(benchmark::State& state) {
+  const auto input = decibelsInput(state.range(0));
+  std::vector<float> output(input.size());
+  for (auto _ : state) {
+    for (uint32_t i = 0; i < input.size(); ++i) {
+      output[i] = 10.0f * std::log10(input[i] * 0.5f);
+    }
+    benchmark::DoNotOptimize(output.data());
+  }
+  state.SetItemsProcessed(state.iterations() * input.size());
+}
+BENCHMARK(DecibelsLog10)->Arg(1024)->Arg(65536);
+
+void DecibelsScalar(benchmark::State& state) {
+  const auto input = decibelsInput(state.range(0));
+  std::vector<float> output(input.size());
+  for (auto _ : state) {
+    toDecibelsScalar(input.data(), output.data(), input.size(), 0.5f);
+    benchmark::DoNotOptimize(output.data());
+  }
+  state.SetItemsProcessed(state.iterations() * input.size());
+}
+BENCHMARK(DecibelsScalar)->Arg(1024)->Arg(65536);
+
+void DecibelsDispatched(benchmark::State& state) {
+  const auto input = decibelsInput(state.range(0));
+  std::vector<float> output(input.size());
+  for (auto _ : state) {
+    toDecibels(input.data(), output.data(), input.size(), 0.5f);
+    benchmark::DoNotOptimize(output.data());
+  }
+  state.SetItemsProcessed(state.iterations() * input.size());
+}
+BENCHMARK(DecibelsDispatched)->Arg(1024)->Arg(65536);
@@ -0,0 +1,45 @@
+#include <algorithms/decimator.h>
+#include <benchmark/benchmark.h>
+#include <liquid/liquid.h>
+#include <utils.h>
+
+#include <vector>
+
+constexpr uint32_t DECIMATOR_INPUT_SAMPLES = 131072;
+constexpr uint32_t DECIMATOR_IIR_ORDER = 1;
+
+std::vector<std::complex<float>> decimatorInput() {
+  std::vector<std::complex<float>> input(DECIMATOR_INPUT_SAMPLES);
+  for (uint32_t i = 0; i < input.size(); ++i) {
+    input[i] = {0.5f * (i % 7), -0.25f * (i % 5)};
+  }
+  return input;
+}
+
+// iirdecim as the recorder workers used it before
+void DecimatorLiquidIir(benchmark::State& state) {
+  const auto rate = state.range(0);
+  auto input = decimatorInput();
+  std::vector<std::complex<float>> output(input.size() / rate);
+  auto decimator = iirdecim_crcf_create_default(rate, DECIMATOR_IIR_ORDER);
+  for (auto _ : state) {
+    iirdecim_crcf_execute_block(decimator, toLiquidComplex(input.data()), output.size(), toLiquidComplex(output.data()));
+    benchmark::DoNotOptimize(output.data());
+  }
+  iirdecim_crcf_destroy(decimator);
+  state.SetItemsProcessed(state.iterations() * input.size());
+}
+BENCHMARK(DecimatorLiquidIir)->Arg(2)->Arg(4)->Arg(5)->Arg(8)->Arg(12)->Arg(40);
+
+void DecimatorMultiStage(benchmark::State& state) {
+  const auto rate = state.range(0);
+  const auto input = decimatorInput();
+  std::vector<std::complex<float>> output(input.size() / rate);
+  Decimator decimator(rate);
+  for (auto _ : state) {
+    decimator.decimate(input.data(), output.size(), output.data());
+    benchmark::DoNotOptimize(output.data());
+  }
+  state.SetItemsProcessed(state.iterations() * input.size());
+}
+BENCHMARK(DecimatorMultiStage)->Arg(2)->Arg(4)->Arg(5)->Arg(8)->Arg(12)->Arg(40);
@@ -0,0 +1,62 @@
+#include <algorithms/fft.h>
+#include <algorithms/fftw_initializer.h>
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+const std::vector<std::string> PLANNERS = {"estimate", "measure", "patient"};
+
+// fft time per size and planner effort, plan time is reported as a counter
+void FftExecute(benchmark::State& state) {
+  const auto size = state.range(0);
+  const auto& planner = PLANNERS[state.range(1)];
+  fftwf_forget_wisdom();
+  const auto start = std::chrono::steady_clock::now();
+  Fft fft(size, size / 2, 1, fftwPlannerFlags(planner));
+  const auto planTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+  std::vector<std::complex<float>> samples(size, {0.5f, -0.5f});
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(fft.compute(samples.data(), size));
+  }
+  state.SetLabel(planner);
+  state.counters["plan_ms"] = planTime.count() / 1000.0;
+}
+BENCHMARK(FftExecute)->ArgsProduct({{1024, 4096, 16384}, {0, 1, 2}});
+
+// magnitude spectrum of several frames, one plan execution per frame against one batched execution
+void FftFramesLoop(benchmark::State& state) {
+  constexpr uint32_t size = 16384;
+  const auto frames = state.range(0);
+  Fft fft(size, size / 2);
+  std::vector<std::complex<float>> samples(size * frames, {0.5f, -0.5f});
+  std::vector<float> power(size);
+  for (auto _ : state) {
+    for (int64_t i = 0; i < frames; ++i) {
+      const auto result = fft.compute(samples.data() + i * size, size);
+      for (uint32_t j = 0; j < size; ++j) {
+        power[j] += std::abs(result[j]);
+      }
+    }
+    benchmark::DoNotOptimize(power.data());
+  }
+}
+BENCHMARK(FftFramesLoop)->Arg(4)->Arg(16);
+
+void FftFramesBatched(benchmark::State& state) {
+  constexpr uint32_t size = 16384;
+  const auto frames = state.range(0);
+  Fft fft(size, size / 2, frames);
+  std::vector<std::complex<float>> samples(size * frames, {0.5f, -0.5f});
+  std::vector<float> power(size);
+  for (auto _ : state) {
+    const auto result = fft.compute(samples.data(), size);
+    for (int64_t i = 0; i < frames; ++i) {
+      const auto frame = result + i * size;
+      for (uint32_t j = 0; j < size; ++j) {
+        power[j] += frame[j].real() * frame[j].real() + frame[j].imag() * frame[j].imag();
+      }
+    }
+    benchmark::DoNotOptimize(power.data());
+  }
+}
+BENCHMARK(FftFramesBatched)->Arg(4)->Arg(16);
@@ -0,0 +1,10 @@
+#include <benchmark/benchmark.h>
+#include <logger.h>
+
+int main(int argc, char **argv) {
+  Logger::configure(spdlog::level::off, spdlog::level::off, "");
+  ::benchmark::Initialize(&argc, argv);
+  ::benchmark::RunSpecifiedBenchmarks();
+  ::benchmark::Shutdown();
+  return 0;
+}
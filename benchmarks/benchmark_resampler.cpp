@@ -0,0 +1,20 @@
+#include <algorithms/resampler.h>
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+constexpr uint32_t RESAMPLER_BENCHMARK_SAMPLES = 65536;
+
+void ResamplerRational(benchmark::State& state) {
+  Resampler resampler({static_cast<uint32_t>(state.range(0)), static_cast<uint32_t>(state.range(1))});
+  std::vector<std::complex<float>> input(RESAMPLER_BENCHMARK_SAMPLES);
+  for (uint32_t i = 0; i < input.size(); ++i) {
+    input[i] = {0.5f * (i % 7), -0.25f * (i % 5)};
+  }
+  std::vector<std::complex<float>> output(resampler.maxOutputSize(input.size()));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(resampler.resample(input.data(), input.size(), output.data()));
+  }
+  state.SetItemsProcessed(state.iterations() * input.size());
+}
+BENCHMARK(ResamplerRational)->Args({74, 75})->Args({159, 160})->Args({3, 2})->Args({199773, 200000});
@@ -0,0 +1,122 @@
+#include <algorithms/nco.h>
+#include <algorithms/spectrogram.h>
+#include <benchmark/benchmark.h>
+#include <config.h>
+#include <simd/convert.h>
+#include <utils.h>
+
+#include <random>
+
+constexpr Frequency SAMPLE_RATE = 2048000;
+constexpr uint32_t SAMPLES = 262144;
+constexpr int32_t OFFSET = 10000;
+
+std::vector<uint8_t> randomBytes(uint32_t size) {
+  std::mt19937 generator(0);
+  std::uniform_int_distribution<int> distribution(0, 255);
+  std::vector<uint8_t> data(size);
+  for (auto& value : data) {
+    value = distribution(generator);
+  }
+  return data;
+}
+
+FrequencyRange benchmarkRange(uint32_t fft) { return {100000000 - SAMPLE_RATE / 2, 100000000 + SAMPLE_RATE / 2, SAMPLE_RATE, fft}; }
+
+std::vector<std::complex<float>> shiftTable(uint32_t size) {
+  std::vector<std::complex<float>> data(size, 1.0f);
+  Nco(OFFSET, SAMPLE_RATE).mix(data.data(), size);
+  return data;
+}
+
+// fft input preparation only: convert, shift and window as separate passes over the whole chunk
+void FftInputThreePasses(benchmark::State& state) {
+  const auto input = randomBytes(2 * SAMPLES);
+  const auto shiftData = shiftTable(SAMPLES);
+  const std::vector<float> window(SAMPLES, 0.5f);
+  std::vector<std::complex<float>> samples(SAMPLES);
+  std::vector<std::complex<float>> output(SAMPLES);
+  for (auto _ : state) {
+    toComplex(input.data(), samples.data(), input.size());
+    for (uint32_t i = 0; i < SAMPLES; ++i) {
+      samples[i] *= shiftData[i];
+    }
+    for (uint32_t i = 0; i < SAMPLES; ++i) {
+      output[i] = samples[i] * window[i];
+    }
+    benchmark::DoNotOptimize(output.data());
+  }
+  state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(FftInputThreePasses);
+
+void FftInputFused(benchmark::State& state) {
+  const auto input = randomBytes(2 * SAMPLES);
+  const auto shiftData = shiftTable(SAMPLES);
+  const std::vector<float> window(SAMPLES, 0.5f);
+  std::vector<std::complex<float>> output(SAMPLES);
+  for (auto _ : state) {
+    convertShiftWindow(input.data(), shiftData.data(), window.data(), output.data(), SAMPLES, SampleFormat::CU8);
+    benchmark::DoNotOptimize(output.data());
+  }
+  state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(FftInputFused);
+
+// whole spectrogram of one worker chunk, as done before and after fusing
+void PsdThreePasses(benchmark::State& state) {
+  const Config config("", "{}");
+  Spectrogram spectrogram(config);
+  const auto range = benchmarkRange(state.range(0));
+  const auto input = randomBytes(2 * SAMPLES);
+  const auto shiftData = shiftTable(SAMPLES);
+  std::vector<std::complex<float>> samples(SAMPLES);
+  for (auto _ : state) {
+    toComplex(input.data(), samples.data(), input.size());
+    for (uint32_t i = 0; i < SAMPLES; ++i) {
+      samples[i] *= shiftData[i];
+    }
+    benchmark::DoNotOptimize(spectrogram.psd(range, samples.data(), SAMPLES));
+  }
+  state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(PsdThreePasses)->Arg(1024)->Arg(8192);
+
+void PsdFused(benchmark::State& state) {
+  const Config config("", "{}");
+  Spectrogram spectrogram(config);
+  const auto range = benchmarkRange(state.range(0));
+  const auto input = randomBytes(2 * SAMPLES);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(spectrogram.psd(range, input.data(), SAMPLES, SampleFormat::CU8, OFFSET));
+  }
+  state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(PsdFused)->Arg(1024)->Arg(8192);
+
+// frequency shift of a recorder chunk, precomputed table against the oscillator
+void ShiftTable(benchmark::State& state) {
+  const auto shiftData = shiftTable(SAMPLES);
+  std::vector<std::complex<float>> samples(SAMPLES, 0.5f);
+  std::vector<std::complex<float>> output(SAMPLES);
+  for (auto _ : state) {
+    for (uint32_t i = 0; i < SAMPLES; ++i) {
+      output[i] = samples[i] * shiftData[i];
+    }
+    benchmark::DoNotOptimize(output.data());
+  }
+  state.SetItemsProcessed(state.iterations() * SAMPLES);
+}
+BENCHMARK(ShiftTable);
+
+void ShiftNco(benchmark::State& state) {
+  Nco nco(OFFSET, SAMPLE_RATE);
+  std::vector<std::complex<float>> samples(SAMPLES, 0.5f);
+  std::vector<std::complex<float>> output(SAMPLES);
+  for (auto _ : state) {
+    nco.mix(samples.data(), output.data(), SAMPLES);
+    benchmark::DoNotOptimize(output.data());
+  }
+  state.SetItemsProcessed(state.iterations() * SAMPLES);
+}
+BENCHMARK(ShiftNco);
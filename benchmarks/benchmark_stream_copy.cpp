@@ -0,0 +1,31 @@
+#include <benchmark/benchmark.h>
+#include <buffer_pool.h>
+
+#include <algorithm>
+#include <vector>
+
+constexpr uint32_t STREAM_COPY_RING_SIZE = 40 * 1024 * 1024;
+constexpr uint32_t STREAM_COPY_POOL_SIZE = 16;
+
+// copy of every streamed chunk out of the device ring buffer into a pooled buffer, as Recorder::processSamples does,
+// chunks are 100 ms of interleaved 8 bit samples, the ring and pool are larger than caches, so copies hit memory
+void StreamCopy(benchmark::State& state) {
+  const uint32_t chunkSize = 2 * state.range(0) / 10;
+  const std::vector<uint8_t> ring(STREAM_COPY_RING_SIZE, 1);
+  BufferPool<uint8_t> pool("StreamPool", STREAM_COPY_POOL_SIZE);
+  std::vector<BufferPool<uint8_t>::Buffer> inFlight(STREAM_COPY_POOL_SIZE - 1);
+  uint32_t offset = 0;
+  uint32_t index = 0;
+  for (auto _ : state) {
+    if (STREAM_COPY_RING_SIZE < offset + chunkSize) {
+      offset = 0;
+    }
+    auto buffer = pool.acquire(chunkSize);
+    std::copy(ring.data() + offset, ring.data() + offset + chunkSize, buffer.data());
+    benchmark::DoNotOptimize(buffer.data());
+    inFlight[index++ % inFlight.size()] = std::move(buffer);
+    offset += chunkSize;
+  }
+  state.SetBytesProcessed(state.iterations() * chunkSize);
+}
+BENCHMARK(StreamCopy)->Arg(2048000)->Arg(10000000)->Arg(20000000);
@@ -0,0 +1,55 @@
+#include <algorithms/signal_generator.h>
+#include <algorithms/spectrogram.h>
+#include <benchmark/benchmark.h>
+#include <config.h>
+
+#include <algorithm>
+
+constexpr Frequency WELCH_FREQUENCY = 100000000;
+constexpr Frequency WELCH_SAMPLE_RATE = 2048000;
+constexpr uint32_t WELCH_FFT = 1024;
+constexpr uint32_t WELCH_SAMPLES = 131072;
+constexpr uint32_t WELCH_CHUNKS = 64;
+constexpr auto WELCH_MARGIN = 10.0f;
+
+// Chunks of 64 ms, each containing one 2 ms burst at a different position, and one chunk without burst for the noise level
+const std::vector<std::vector<uint8_t>>& burstChunks() {
+  static const auto chunks = []() {
+    const Config config("", R"({"devices": {"generator": {"noise": -30, "transmissions": [{"frequency": 100100000, "power": -25, "period_ms": 100, "duty_cycle": 0.02}]}}})");
+    SignalGenerator generator(config);
+    const FrequencyRange range{WELCH_FREQUENCY - WELCH_SAMPLE_RATE / 2, WELCH_FREQUENCY + WELCH_SAMPLE_RATE / 2, WELCH_SAMPLE_RATE, WELCH_FFT};
+    std::vector<std::vector<uint8_t>> chunks(WELCH_CHUNKS + 1, std::vector<uint8_t>(2 * WELCH_SAMPLES));
+    for (uint32_t i = 0; i < WELCH_CHUNKS; ++i) {
+      const auto position = std::chrono::microseconds(2000 + i * 60000 / WELCH_CHUNKS);
+      generator.generate(range, std::chrono::milliseconds(100 * (i + 1)) - position, chunks[i].data(), chunks[i].size());
+    }
+    generator.generate(range, std::chrono::milliseconds(10), chunks.back().data(), chunks.back().size());
+    return chunks;
+  }();
+  return chunks;
+}
+
+// cost of the spectrogram of one chunk against the share of chunks where the burst rises above noise by the margin
+void WelchBurstDetection(benchmark::State& state) {
+  const auto budget = state.range(0) / 100.0f;
+  const auto overlap = state.range(1) / 100.0f;
+  const Config config("", R"({"detection": {"welch_budget": )" + std::to_string(budget) + R"(, "welch_max_overlap": )" + std::to_string(overlap) + "}}");
+  const FrequencyRange range{WELCH_FREQUENCY - WELCH_SAMPLE_RATE / 2, WELCH_FREQUENCY + WELCH_SAMPLE_RATE / 2, WELCH_SAMPLE_RATE, WELCH_FFT};
+  const auto& chunks = burstChunks();
+  Spectrogram spectrogram(config);
+
+  const auto noiseSpectrum = spectrogram.psd(range, chunks.back().data(), WELCH_SAMPLES, SampleFormat::CU8, 0);
+  std::vector<float> noise(noiseSpectrum.data(), noiseSpectrum.data() + noiseSpectrum.size());
+  std::nth_element(noise.begin(), noise.begin() + noise.size() / 2, noise.end());
+  const auto threshold = noise[noise.size() / 2] + WELCH_MARGIN;
+
+  uint64_t detections = 0;
+  uint64_t index = 0;
+  for (auto _ : state) {
+    const auto spectrum = spectrogram.psd(range, chunks[index++ % WELCH_CHUNKS].data(), WELCH_SAMPLES, SampleFormat::CU8, 0);
+    detections += threshold <= spectrum[spectrum.lowerBound(100100000)];
+  }
+  state.counters["detection"] = static_cast<double>(detections) / state.iterations();
+  state.SetItemsProcessed(state.iterations() * WELCH_SAMPLES);
+}
+BENCHMARK(WelchBurstDetection)->ArgsProduct({{5, 10, 25, 50, 100, 200}, {0, 50}});
@@ -0,0 +1,11 @@
+#include "channelizer.h"
+
+#include <algorithms/overlap_save_channelizer.h>
+#include <algorithms/polyphase_channelizer.h>
+
+std::unique_ptr<Channelizer> createChannelizer(const Config& config, Frequency sampleRate, uint32_t decimation) {
+  if (config.recordingChannelizer() == "overlap_save") {
+    return std::make_unique<OverlapSaveChannelizer>(config, sampleRate, decimation);
+  }
+  return std::make_unique<PolyphaseChannelizer>(config, sampleRate, decimation);
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <config.h>
+#include <radio/help_structures.h>
+
+#include <complex>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Splits the input into channels around requested frequencies and decimates them, sharing the work between all
+// recordings of a chunk. Filter state carries over between calls. The distance of a requested frequency from its
+// channel center is returned as residual and left to the caller, as is the rest of the decimation (workerDecimation).
+class Channelizer {
+ public:
+  struct Channel {
+    uint32_t index;
+    int32_t residual;
+  };
+
+  virtual ~Channelizer() = default;
+
+  virtual Channel channel(int32_t frequency) const = 0;
+  virtual Frequency sampleRate() const = 0;
+  virtual Frequency outputSampleRate() const = 0;
+  virtual uint32_t workerDecimation() const = 0;
+  // number of samples written to every output by the next process() of inputSize samples
+  virtual uint32_t outputSize(uint32_t inputSize) const = 0;
+  virtual void process(const std::complex<float>* input, uint32_t size, const std::vector<uint32_t>& channels, const std::vector<std::complex<float>*>& outputs) = 0;
+  // clears filter state, so the next process() starts a new stream
+  virtual void reset() = 0;
+};
+
+// decimation is the total one, from sampleRate to the recording sample rate
+std::unique_ptr<Channelizer> createChannelizer(const Config& config, Frequency sampleRate, uint32_t decimation);
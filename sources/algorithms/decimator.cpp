@@ -1,15 +1,142 @@
 #include "decimator.h"
 
+#include <liquid/liquid.h>
 #include <logger.h>
-#include <utils.h>
+#include <simd/fir.h>
 
-Decimator::Decimator(const Config &config, uint32_t rate) : m_rate(rate), m_decimator(iirdecim_crcf_create_default(rate, config.resamplerFilterLength())) {
-  Logger::debug("decimator", "init, rate: {}, filter length: {}", m_rate, config.resamplerFilterLength());
+#include <algorithm>
+#include <numeric>
+
+constexpr auto DECIMATOR_PASSBAND = 0.4f;
+constexpr auto DECIMATOR_ATTENUATION = 60.0f;
+constexpr uint32_t DECIMATOR_CIC_ORDER = 3;
+constexpr uint32_t DECIMATOR_CIC_MIN_HALF_BANDS = 3;
+
+// The passband is given relative to the stage input rate. With at least three half-bands after it, the CIC droop at
+// the passband edge stays below 0.15 dB and its first image is attenuated by more than 70 dB.
+Decimator::Decimator(uint32_t rate) : m_rate(std::max(1u, rate)) {
+  auto halfBands = 0u;
+  auto remainder = m_rate;
+  while (remainder % 2 == 0) {
+    remainder /= 2;
+    halfBands++;
+  }
+
+  auto passband = DECIMATOR_PASSBAND / m_rate;
+  if (1 < remainder) {
+    const auto type = DECIMATOR_CIC_MIN_HALF_BANDS <= halfBands ? StageType::CIC : StageType::FIR;
+    m_stages.push_back(createStage(type, remainder, passband));
+    passband *= remainder;
+  }
+  for (uint32_t i = 0; i < halfBands; ++i) {
+    m_stages.push_back(createStage(StageType::HALF_BAND, 2, passband));
+    passband *= 2;
+  }
+
+  std::string stages;
+  for (const auto& stage : m_stages) {
+    stages += (stages.empty() ? "" : ", ") + toString(stage.type) + " " + std::to_string(stage.rate) + "x" + std::to_string(stage.taps.size());
+  }
+  Logger::debug("decimator", "init, rate: {}, stages: [{}]", m_rate, stages);
+}
+
+// All filters are symmetric, so taps need no reversal for the convolution. The CIC is evaluated in its non-recursive
+// form, the impulse response of the integrator and comb cascade, which avoids unbounded integrators in floats.
+Decimator::Stage Decimator::createStage(StageType type, uint32_t rate, float passband) {
+  Stage stage{type, rate, {}, 0.0f, {}, {}, {}};
+  if (type == StageType::CIC) {
+    stage.taps = {1.0f};
+    for (uint32_t i = 0; i < DECIMATOR_CIC_ORDER; ++i) {
+      std::vector<float> taps(stage.taps.size() + rate - 1, 0.0f);
+      for (uint32_t j = 0; j < stage.taps.size(); ++j) {
+        for (uint32_t k = 0; k < rate; ++k) {
+          taps[j + k] += stage.taps[j];
+        }
+      }
+      stage.taps = std::move(taps);
+    }
+  } else if (type == StageType::FIR) {
+    const auto stopband = 1.0f / rate - passband;
+    // the length estimate runs short for filters of a few taps, so it is rounded up to the next odd length plus two
+    const auto length = estimate_req_filter_len(stopband - passband, DECIMATOR_ATTENUATION) / 2 * 2 + 3;
+    stage.taps.resize(length);
+    liquid_firdes_kaiser(length, 0.5f / rate, DECIMATOR_ATTENUATION, 0.0f, stage.taps.data());
+  } else {
+    // length 4k + 3 puts a zero on every even distance from the center, only odd distances and the center are kept
+    const auto length = estimate_req_filter_len(0.5f - 2.0f * passband, DECIMATOR_ATTENUATION) / 4 * 4 + 3;
+    std::vector<float> taps(length);
+    liquid_firdes_kaiser(length, 0.25f, DECIMATOR_ATTENUATION, 0.0f, taps.data());
+    const auto gain = std::accumulate(taps.begin(), taps.end(), 0.0f);
+    for (uint32_t i = 0; i < length; i += 2) {
+      stage.taps.push_back(taps[i] / gain);
+    }
+    stage.centerTap = taps[length / 2] / gain;
+    stage.buffer.assign(length - 1, 0.0f);
+    return stage;
+  }
+  const auto gain = std::accumulate(stage.taps.begin(), stage.taps.end(), 0.0f);
+  for (auto& tap : stage.taps) {
+    tap /= gain;
+  }
+  stage.buffer.assign(stage.taps.size() - 1, 0.0f);
+  return stage;
 }
 
-Decimator::~Decimator() {
-  Logger::debug("decimator", "deinit");
-  iirdecim_crcf_destroy(m_decimator);
+std::string Decimator::toString(StageType type) {
+  switch (type) {
+    case StageType::CIC:
+      return "cic";
+    case StageType::FIR:
+      return "fir";
+    default:
+      return "half-band";
+  }
 }
 
-void Decimator::decimate(std::complex<float> *in, uint32_t size, std::complex<float> *out) { iirdecim_crcf_execute_block(m_decimator, toLiquidComplex(in), size, toLiquidComplex(out)); }
+void Decimator::decimate(const std::complex<float>* in, uint32_t size, std::complex<float>* out) {
+  if (m_stages.empty()) {
+    std::copy(in, in + size, out);
+    return;
+  }
+  auto input = in;
+  auto inputSize = size * m_rate;
+  for (uint32_t i = 0; i < m_stages.size(); ++i) {
+    auto& stage = m_stages[i];
+    const auto outputSize = inputSize / stage.rate;
+    if (i + 1 < m_stages.size() && stage.output.size() < outputSize) {
+      stage.output.resize(outputSize);
+    }
+    auto output = i + 1 < m_stages.size() ? stage.output.data() : out;
+    process(stage, input, inputSize, output);
+    input = output;
+    inputSize = outputSize;
+  }
+}
+
+void Decimator::reset() {
+  for (auto& stage : m_stages) {
+    std::fill(stage.buffer.begin(), stage.buffer.end(), 0.0f);
+  }
+}
+
+// The history holds the last taps - 1 samples. A half-band is split into phases: even samples meet the odd distance
+// taps in a contiguous FIR and the odd samples only meet the center tap.
+void Decimator::process(Stage& stage, const std::complex<float>* in, uint32_t inSize, std::complex<float>* out) {
+  const auto history = stage.buffer.size();
+  const auto outSize = inSize / stage.rate;
+  stage.buffer.insert(stage.buffer.end(), in, in + inSize);
+  if (stage.type == StageType::HALF_BAND) {
+    const auto center = history / 2;
+    stage.phase.resize(center + outSize);
+    for (uint32_t i = 0; i < stage.phase.size(); ++i) {
+      stage.phase[i] = stage.buffer[2 * i];
+    }
+    fir(stage.phase.data(), stage.taps.data(), stage.taps.size(), 1, out, outSize);
+    for (uint32_t i = 0; i < outSize; ++i) {
+      out[i] += stage.centerTap * stage.buffer[2 * i + center];
+    }
+  } else {
+    fir(stage.buffer.data(), stage.taps.data(), stage.taps.size(), stage.rate, out, outSize);
+  }
+  stage.buffer.erase(stage.buffer.begin(), stage.buffer.begin() + outSize * stage.rate);
+}
@@ -1,20 +1,39 @@
 #pragma once
 
-#include <config.h>
-#include <liquid/liquid.h>
-
 #include <complex>
 #include <cstdint>
+#include <string>
+#include <vector>
 
+// Multi-stage FIR decimator. Factors of two are taken by half-band stages at the end of the chain, the odd remainder
+// first by a CIC stage when enough half-bands follow to hide its droop, otherwise by a Kaiser FIR. Every stage keeps
+// its own history, so consecutive chunks are decimated as one continuous stream.
 class Decimator {
  public:
-  Decimator(const Config& config, uint32_t rate);
-  ~Decimator();
+  explicit Decimator(uint32_t rate);
 
-  void decimate(std::complex<float>* in, uint32_t size, std::complex<float>* out);
+  // reads size * rate input samples and writes size output samples
+  void decimate(const std::complex<float>* in, uint32_t size, std::complex<float>* out);
+  // clears the history, so the filters can be reused for another stream
+  void reset();
 
  private:
-  const uint32_t m_rate;
+  enum class StageType { CIC, FIR, HALF_BAND };
+
+  struct Stage {
+    StageType type;
+    uint32_t rate;
+    std::vector<float> taps;
+    float centerTap;
+    std::vector<std::complex<float>> buffer;
+    std::vector<std::complex<float>> phase;
+    std::vector<std::complex<float>> output;
+  };
 
-  iirdecim_crcf m_decimator;
+  static Stage createStage(StageType type, uint32_t rate, float passband);
+  static std::string toString(StageType type);
+  void process(Stage& stage, const std::complex<float>* in, uint32_t inSize, std::complex<float>* out);
+
+  const uint32_t m_rate;
+  std::vector<Stage> m_stages;
 };
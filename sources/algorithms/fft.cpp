@@ -1,37 +1,85 @@
 #include "fft.h"
 
+#include <algorithms/fftw_initializer.h>
 #include <liquid/liquid.h>
 #include <logger.h>
+#include <simd/convert.h>
 
 #include <mutex>
 
-Fft::Fft(uint32_t fftSize, uint32_t windowSize) : m_fftSize(fftSize), m_windowSize(windowSize) {
-  Logger::info("fft", "init size: {}", fftSize);
-  m_in.resize(fftSize);
-  m_out.resize(fftSize);
-  m_window.resize(m_windowSize);
+std::complex<float> *allocate(uint32_t size) { return reinterpret_cast<std::complex<float> *>(fftwf_alloc_complex(size)); }
+
+Fft::Fft(uint32_t fftSize, uint32_t windowSize, uint32_t frames, unsigned plannerFlags)
+    : m_fftSize(fftSize),
+      m_windowSize(windowSize),
+      m_frames(frames),
+      m_in(allocate(fftSize * frames)),
+      m_out(allocate(fftSize * frames)),
+      m_window(windowSize),
+      m_executions(0),
+      m_executionTime(0) {
   for (uint32_t i = 0; i < windowSize; ++i) {
     m_window[i] = hamming(i, windowSize);
   }
-  static std::mutex mutex;
-  std::unique_lock<std::mutex> lock(mutex);
-  m_plan = fftwf_plan_dft_1d(fftSize, reinterpret_cast<fftwf_complex *>(m_in.data()), reinterpret_cast<fftwf_complex *>(m_out.data()), FFTW_FORWARD, FFTW_ESTIMATE);
+  std::unique_lock<std::mutex> lock(fftwPlannerMutex());
+  const auto start = std::chrono::steady_clock::now();
+  const int size = fftSize;
+  auto in = reinterpret_cast<fftwf_complex *>(m_in.get());
+  auto out = reinterpret_cast<fftwf_complex *>(m_out.get());
+  auto plan = [&](unsigned flags) { return fftwf_plan_many_dft(1, &size, frames, in, nullptr, 1, fftSize, out, nullptr, 1, fftSize, FFTW_FORWARD, flags); };
+  m_plan = plan(plannerFlags | FFTW_WISDOM_ONLY);
+  const auto isWisdom = m_plan != nullptr;
+  if (!isWisdom) {
+    m_plan = plan(plannerFlags);
+  }
+  // planning may overwrite buffers, zero padding is written once here and never touched by compute
+  std::fill(m_in.get(), m_in.get() + fftSize * frames, std::complex<float>(0.0f, 0.0f));
+  const auto planTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+  Logger::info("fft", "init size: {}, frames: {}, from wisdom: {}, plan time: {:.1f} ms", fftSize, frames, isWisdom, planTime.count() / 1000.0f);
 }
 
 Fft::~Fft() {
-  Logger::info("fft", "deinit");
+  Logger::info(
+      "fft",
+      "deinit size: {}, frames: {}, executions: {}, average time: {:.1f} us",
+      m_fftSize,
+      m_frames,
+      m_executions,
+      m_executions ? static_cast<float>(m_executionTime.count()) / m_executions / 1000.0f : 0.0f);
+  std::unique_lock<std::mutex> lock(fftwPlannerMutex());
   fftwf_destroy_plan(m_plan);
 }
 
-std::complex<float> *Fft::compute(std::complex<float> *in) {
-  for (uint32_t i = 0; i < m_windowSize; ++i) {
-    m_in[i].imag(in[i].imag() * m_window[i]);
-    m_in[i].real(in[i].real() * m_window[i]);
+const std::complex<float> *Fft::compute(const std::complex<float> *in, uint32_t stride) {
+  for (uint32_t frame = 0; frame < m_frames; ++frame) {
+    const auto input = in + frame * stride;
+    const auto output = m_in.get() + frame * m_fftSize;
+    for (uint32_t i = 0; i < m_windowSize; ++i) {
+      output[i] = input[i] * m_window[i];
+    }
   }
-  for (uint32_t i = m_windowSize; i < m_fftSize; ++i) {
-    m_in[i].imag(0.0f);
-    m_in[i].real(0.0f);
+  return execute();
+}
+
+const std::complex<float> *Fft::compute(const uint8_t *in, uint32_t stride, const std::complex<float> *shift, SampleFormat format) {
+  for (uint32_t frame = 0; frame < m_frames; ++frame) {
+    convertShiftWindow(in + 2 * frame * stride, shift, m_window.data(), m_in.get() + frame * m_fftSize, m_windowSize, format);
   }
+  return execute();
+}
+
+float Fft::windowPower() const {
+  float power = 0.0f;
+  for (const auto value : m_window) {
+    power += value * value;
+  }
+  return power;
+}
+
+const std::complex<float> *Fft::execute() {
+  const auto start = std::chrono::steady_clock::now();
   fftwf_execute(m_plan);
-  return m_out.data();
+  m_executionTime += std::chrono::steady_clock::now() - start;
+  ++m_executions;
+  return m_out.get();
 }
@@ -1,23 +1,40 @@
 #pragma once
 
 #include <fftw3.h>
+#include <radio/help_structures.h>
 
+#include <chrono>
 #include <complex>
 #include <cstdint>
+#include <memory>
 #include <vector>
 
+// Transforms all frames with a single batched plan. Frame i is read from in + i * stride samples, only its first
+// windowSize samples are windowed and used, the rest of the frame is zero padded.
 class Fft {
  public:
-  Fft(uint32_t fftSize, uint32_t windowSize);
+  Fft(uint32_t fftSize, uint32_t windowSize, uint32_t frames = 1, unsigned plannerFlags = FFTW_ESTIMATE);
   ~Fft();
 
-  std::complex<float>* compute(std::complex<float>* in);
+  const std::complex<float>* compute(const std::complex<float>* in, uint32_t stride);
+  const std::complex<float>* compute(const uint8_t* in, uint32_t stride, const std::complex<float>* shift, SampleFormat format);
+  float windowPower() const;
 
  private:
+  struct FftwDeleter {
+    void operator()(std::complex<float>* data) const { fftwf_free(data); }
+  };
+  using FftwBuffer = std::unique_ptr<std::complex<float>[], FftwDeleter>;
+
+  const std::complex<float>* execute();
+
   const uint32_t m_fftSize;
   const uint32_t m_windowSize;
-  std::vector<std::complex<float>> m_in;
-  std::vector<std::complex<float>> m_out;
+  const uint32_t m_frames;
+  FftwBuffer m_in;
+  FftwBuffer m_out;
   std::vector<float> m_window;
   fftwf_plan m_plan;
+  uint64_t m_executions;
+  std::chrono::nanoseconds m_executionTime;
 };
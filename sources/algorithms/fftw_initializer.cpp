@@ -1,15 +1,54 @@
 #include "fftw_initializer.h"
 
 #include <fftw3.h>
+#include <logger.h>
 
-FftwInitializer::FftwInitializer(uint8_t cores) {
-  fftw_init_threads();
-  fftwf_init_threads();
-  fftw_plan_with_nthreads(cores);
-  fftwf_plan_with_nthreads(cores);
+#include <filesystem>
+
+constexpr auto FFTW_PLAN_TIME_LIMIT_SECONDS = 1.0;
+
+std::mutex& fftwPlannerMutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
+unsigned fftwPlannerFlags(const std::string& planner) {
+  if (planner == "estimate")
+    return FFTW_ESTIMATE;
+  else if (planner == "measure")
+    return FFTW_MEASURE;
+  else if (planner == "patient")
+    return FFTW_PATIENT;
+  Logger::warn("fftw", "unknown planner: {}, using estimate", planner);
+  return FFTW_ESTIMATE;
+}
+
+FftwInitializer::FftwInitializer(const Config& config) : m_wisdomPath(config.fftwWisdomPath()) {
+  std::unique_lock<std::mutex> lock(fftwPlannerMutex());
+  fftwf_set_timelimit(FFTW_PLAN_TIME_LIMIT_SECONDS);
+  if (m_wisdomPath.empty()) {
+    return;
+  }
+  if (fftwf_import_wisdom_from_filename(m_wisdomPath.c_str())) {
+    Logger::info("fftw", "wisdom loaded: {}", m_wisdomPath);
+  } else {
+    Logger::info("fftw", "wisdom not loaded: {}, plans will be measured", m_wisdomPath);
+  }
 }
 
 FftwInitializer::~FftwInitializer() {
-  fftw_cleanup_threads();
-  fftwf_cleanup_threads();
+  if (m_wisdomPath.empty()) {
+    return;
+  }
+  std::unique_lock<std::mutex> lock(fftwPlannerMutex());
+  std::error_code error;
+  const auto directory = std::filesystem::path(m_wisdomPath).parent_path();
+  if (!directory.empty()) {
+    std::filesystem::create_directories(directory, error);
+  }
+  if (fftwf_export_wisdom_to_filename(m_wisdomPath.c_str())) {
+    Logger::info("fftw", "wisdom saved: {}", m_wisdomPath);
+  } else {
+    Logger::warn("fftw", "can not save wisdom: {}", m_wisdomPath);
+  }
 }
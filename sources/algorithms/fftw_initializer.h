@@ -1,9 +1,21 @@
 #pragma once
 
-#include <cstdint>
+#include <config.h>
 
+#include <mutex>
+#include <string>
+
+// FFTW planner is not thread safe, plans are created and destroyed under this mutex
+std::mutex& fftwPlannerMutex();
+
+unsigned fftwPlannerFlags(const std::string& planner);
+
+// Loads FFTW wisdom on start and saves it on exit, so plans measured once on a machine are reused after restarts.
 class FftwInitializer {
  public:
-  FftwInitializer(uint8_t cores);
+  FftwInitializer(const Config& config);
   ~FftwInitializer();
+
+ private:
+  const std::string m_wisdomPath;
 };
@@ -0,0 +1,23 @@
+#include "nco.h"
+
+#include <simd/rotate.h>
+
+#include <cmath>
+
+constexpr uint32_t NCO_BLOCK_SIZE = 1024;
+constexpr double TWO_PI = 2.0 * M_PI;
+
+Nco::Nco(int32_t frequency, Frequency sampleRate)
+    : m_step(TWO_PI * static_cast<double>(frequency) / static_cast<double>(sampleRate)), m_stepFactor(std::polar(1.0, m_step)), m_phase(0.0) {}
+
+void Nco::mix(const std::complex<float>* input, std::complex<float>* output, uint32_t size) {
+  for (uint32_t i = 0; i < size; i += NCO_BLOCK_SIZE) {
+    const auto blockSize = std::min(NCO_BLOCK_SIZE, size - i);
+    rotate(input + i, output + i, blockSize, std::complex<float>(std::polar(1.0, m_phase)), m_stepFactor);
+    skip(blockSize);
+  }
+}
+
+void Nco::mix(std::complex<float>* samples, uint32_t size) { mix(samples, samples, size); }
+
+void Nco::skip(uint32_t size) { m_phase = std::fmod(m_phase + m_step * size, TWO_PI); }
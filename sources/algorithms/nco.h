@@ -0,0 +1,22 @@
+#pragma once
+
+#include <radio/help_structures.h>
+
+#include <complex>
+#include <cstdint>
+
+// Numerically controlled oscillator, mixes samples up by frequency. Phase carries over between calls, so consecutive
+// chunks are mixed as one continuous stream and no table of the chunk size is needed.
+class Nco {
+ public:
+  Nco(int32_t frequency, Frequency sampleRate);
+
+  void mix(const std::complex<float>* input, std::complex<float>* output, uint32_t size);
+  void mix(std::complex<float>* samples, uint32_t size);
+  void skip(uint32_t size);
+
+ private:
+  const double m_step;
+  const std::complex<float> m_stepFactor;
+  double m_phase;
+};
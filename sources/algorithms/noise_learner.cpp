@@ -2,67 +2,64 @@
 
 #include <logger.h>
 
+#include <algorithm>
+#include <limits>
+
 NoiseLearner::NoiseLearner(const Config& config) : m_config(config), m_learningNoiseFinished(false) {}
 
-std::vector<Signal> NoiseLearner::getStrongSignals(const std::vector<Signal>& signals) const {
-  const auto signalsBegin = signals.begin();
-  const auto signalsEnd = signals.end();
-  const auto noiseBegin = m_frequencyNoise.lower_bound(signals.front().frequency);
-  const auto noiseEnd = m_frequencyNoise.upper_bound(signals.back().frequency);
-  if (std::distance(signalsBegin, signalsEnd) != std::distance(noiseBegin, noiseEnd)) {
+std::vector<Signal> NoiseLearner::getStrongSignals(const Spectrum& spectrum) const {
+  const auto it = m_frequencyNoise.find(spectrum.frequencyRange());
+  if (it == m_frequencyNoise.end() || it->second.noiseLevel.size() != spectrum.size()) {
     Logger::warn("NoiseLrn", "signals and noise do not match");
     return {};
   }
 
   std::vector<Signal> strongSignals;
-  auto itSignal = signalsBegin;
-  auto itNoise = noiseBegin;
-  while (itSignal != signalsEnd && itNoise != noiseEnd) {
-    if (itNoise->second.noiseLevel <= itSignal->power) {
-      strongSignals.push_back(*itSignal);
+  const auto power = spectrum.data();
+  const auto noiseLevel = it->second.noiseLevel.data();
+  for (uint32_t i = 0; i < spectrum.size(); ++i) {
+    if (noiseLevel[i] <= power[i]) {
+      strongSignals.push_back({spectrum.frequency(i), power[i]});
     }
-    itSignal++;
-    itNoise++;
   }
   return strongSignals;
 }
 
-void NoiseLearner::update(const std::vector<Signal>& signals, const std::vector<std::pair<FrequencyRange, bool>>& activeFrequencies) {
-  const auto existingSignals = std::distance(m_frequencyNoise.lower_bound(signals.front().frequency), m_frequencyNoise.upper_bound(signals.back().frequency));
-  if (static_cast<uint32_t>(existingSignals) != signals.size()) {
-    Logger::info("NoiseLrn", "initialize, {}, {}", frequencyToString(signals.front().frequency, "start"), frequencyToString(signals.back().frequency, "stop"));
-    for (const auto& signal : signals) {
-      m_frequencyNoise.insert({signal.frequency, {0, -std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity()}});
-    }
-  } else {
-    const auto noiseLearningTime = std::chrono::duration_cast<std::chrono::milliseconds>(m_config.noiseLearningTime());
-    const auto learningSamplesCount = noiseLearningTime.count() / m_config.frequencyRangeScanningTime().count();
-    const auto signalsBegin = signals.begin();
-    const auto signalsEnd = signals.end();
-    const auto noiseBegin = m_frequencyNoise.lower_bound(signals.front().frequency);
-    const auto noiseEnd = m_frequencyNoise.upper_bound(signals.back().frequency);
-    if (std::distance(signalsBegin, signalsEnd) != std::distance(noiseBegin, noiseEnd)) {
-      Logger::warn("NoiseLrn", "signals and noise do not match");
+void NoiseLearner::update(const Spectrum& spectrum, const std::vector<std::pair<FrequencyRange, bool>>& activeFrequencies) {
+  auto& noise = m_frequencyNoise[spectrum.frequencyRange()];
+  const auto size = spectrum.size();
+  if (noise.noiseLevel.size() != size) {
+    Logger::info("NoiseLrn", "initialize, {}, {}", frequencyToString(spectrum.frequency(0), "start"), frequencyToString(spectrum.frequency(size - 1), "stop"));
+    noise.samplesCount.assign(size, 0);
+    noise.sampleMax.assign(size, -std::numeric_limits<float>::infinity());
+    noise.noiseLevel.assign(size, std::numeric_limits<float>::infinity());
+    return;
+  }
+
+  m_isActive.assign(size, 0);
+  for (const auto& [frequencyRange, isActive] : activeFrequencies) {
+    const auto begin = spectrum.lowerBound(frequencyRange.start);
+    const auto end = spectrum.lowerBound(frequencyRange.stop + 1);
+    std::fill(m_isActive.begin() + begin, m_isActive.begin() + std::max(begin, end), 1);
+  }
+
+  const auto noiseLearningTime = std::chrono::duration_cast<std::chrono::milliseconds>(m_config.noiseLearningTime());
+  const auto learningSamplesCount = noiseLearningTime.count() / m_config.frequencyRangeScanningTime().count();
+  const auto margin = m_config.noiseDetectionMargin();
+  const auto power = spectrum.data();
+  const auto samplesCount = noise.samplesCount.data();
+  const auto sampleMax = noise.sampleMax.data();
+  const auto noiseLevel = noise.noiseLevel.data();
+  for (uint32_t i = 0; i < size; ++i) {
+    if (m_isActive[i]) {
+      continue;
     }
-    auto itSignal = signalsBegin;
-    auto itNoise = noiseBegin;
-    while (itSignal != signalsEnd && itNoise != noiseEnd) {
-      auto f = [itSignal](const std::pair<FrequencyRange, bool>& data) { return data.first.start <= itSignal->frequency && itSignal->frequency <= data.first.stop; };
-      if (std::any_of(activeFrequencies.begin(), activeFrequencies.end(), f)) {
-        itSignal++;
-        itNoise++;
-        continue;
-      }
-      auto& noise = itNoise->second;
-      noise.samplesCount++;
-      noise.sampleMax = std::max(noise.sampleMax, itSignal->power);
-      if (learningSamplesCount <= noise.samplesCount) {
-        noise.noiseLevel = noise.sampleMax + m_config.noiseDetectionMargin();
-        noise.samplesCount = 0;
-        noise.sampleMax = -std::numeric_limits<float>::infinity();
-      }
-      itSignal++;
-      itNoise++;
+    samplesCount[i]++;
+    sampleMax[i] = std::max(sampleMax[i], power[i]);
+    if (learningSamplesCount <= samplesCount[i]) {
+      noiseLevel[i] = sampleMax[i] + margin;
+      samplesCount[i] = 0;
+      sampleMax[i] = -std::numeric_limits<float>::infinity();
     }
   }
 }
@@ -9,17 +9,19 @@
 class NoiseLearner {
  public:
   NoiseLearner(const Config& config);
-  std::vector<Signal> getStrongSignals(const std::vector<Signal>& signals) const;
-  void update(const std::vector<Signal>& signals, const std::vector<std::pair<FrequencyRange, bool>>& activeFrequencies);
+  std::vector<Signal> getStrongSignals(const Spectrum& spectrum) const;
+  void update(const Spectrum& spectrum, const std::vector<std::pair<FrequencyRange, bool>>& activeFrequencies);
 
  private:
+  // per bin values of one frequency range, indexed like the spectrum
   struct Noise {
-    uint32_t samplesCount;
-    float sampleMax;
-    float noiseLevel;
+    AlignedVector<uint32_t> samplesCount;
+    AlignedVector<float> sampleMax;
+    AlignedVector<float> noiseLevel;
   };
 
   const Config& m_config;
   bool m_learningNoiseFinished;
-  std::map<Frequency, Noise> m_frequencyNoise;
+  std::map<FrequencyRange, Noise> m_frequencyNoise;
+  std::vector<uint8_t> m_isActive;
 };
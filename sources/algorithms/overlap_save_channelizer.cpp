@@ -0,0 +1,127 @@
+#include "overlap_save_channelizer.h"
+
+#include <algorithms/fftw_initializer.h>
+#include <liquid/liquid.h>
+#include <logger.h>
+#include <simd/complex_avx2.h>
+
+#include <cmath>
+#include <mutex>
+#include <numeric>
+
+constexpr auto OVERLAP_SAVE_PASSBAND = 0.4f;
+constexpr auto OVERLAP_SAVE_ATTENUATION = 60.0f;
+constexpr uint32_t OVERLAP_SAVE_MIN_OUTPUT_FFT_SIZE = 64;
+constexpr uint32_t OVERLAP_SAVE_MAX_OVERLAP_FRACTION = 4;
+
+// The filter passes the recording bandwidth and stops at the edge of the bins taken by a channel, so dropping the
+// other bins does not lengthen it. The overlap covers the filter and is a multiple of the decimation, and the output
+// fft is large enough to keep the overlap below a quarter of every block.
+OverlapSaveChannelizer::OverlapSaveChannelizer(const Config& config, Frequency sampleRate, uint32_t decimation)
+    : m_sampleRate(sampleRate), m_decimation(std::max(1u, decimation)), m_position(0) {
+  const auto passband = std::min(OVERLAP_SAVE_PASSBAND * config.minRecordingSampleRate() / sampleRate, OVERLAP_SAVE_PASSBAND / m_decimation);
+  const auto stopband = 0.5f / m_decimation;
+  const auto length = estimate_req_filter_len(stopband - passband, OVERLAP_SAVE_ATTENUATION);
+  std::vector<float> filter(length);
+  liquid_firdes_kaiser(length, (passband + stopband) / 2.0f, OVERLAP_SAVE_ATTENUATION, 0.0f, filter.data());
+  const auto gain = std::accumulate(filter.begin(), filter.end(), 0.0f);
+
+  m_overlap = (length - 1 + m_decimation - 1) / m_decimation * m_decimation;
+  m_outputFftSize = OVERLAP_SAVE_MIN_OUTPUT_FFT_SIZE;
+  while (m_outputFftSize * m_decimation < OVERLAP_SAVE_MAX_OVERLAP_FRACTION * m_overlap) {
+    m_outputFftSize *= 2;
+  }
+  m_fftSize = m_outputFftSize * m_decimation;
+  m_step = m_fftSize - m_overlap;
+
+  // response of the bins taken by a channel, negative frequencies in the upper half as the inverse fft expects,
+  // with the normalization of both ffts folded in
+  m_response.resize(m_outputFftSize);
+  for (uint32_t i = 0; i < m_outputFftSize; ++i) {
+    const auto bin = static_cast<double>(i) - (i < m_outputFftSize / 2 ? 0.0 : static_cast<double>(m_outputFftSize));
+    std::complex<double> response = 0.0;
+    for (uint32_t j = 0; j < length; ++j) {
+      response += static_cast<double>(filter[j]) * std::polar(1.0, -2.0 * M_PI * bin * j / m_fftSize);
+    }
+    m_response[i] = std::complex<float>(response / static_cast<double>(gain) / static_cast<double>(m_fftSize));
+  }
+  m_twiddles.resize(m_fftSize);
+  for (uint32_t i = 0; i < m_fftSize; ++i) {
+    m_twiddles[i] = std::polar(1.0, -2.0 * M_PI * i / m_fftSize);
+  }
+  reset();
+
+  m_in.resize(m_fftSize);
+  m_out.resize(m_fftSize);
+  m_channelIn.resize(m_outputFftSize);
+  m_channelOut.resize(m_outputFftSize);
+  std::unique_lock<std::mutex> lock(fftwPlannerMutex());
+  const auto plannerFlags = fftwPlannerFlags(config.fftPlanner());
+  auto plan = [&](AlignedVector<std::complex<float>>& in, AlignedVector<std::complex<float>>& out, int sign) {
+    auto fftIn = reinterpret_cast<fftwf_complex*>(in.data());
+    auto fftOut = reinterpret_cast<fftwf_complex*>(out.data());
+    auto result = fftwf_plan_dft_1d(in.size(), fftIn, fftOut, sign, plannerFlags | FFTW_WISDOM_ONLY);
+    return result ? result : fftwf_plan_dft_1d(in.size(), fftIn, fftOut, sign, plannerFlags);
+  };
+  m_forwardPlan = plan(m_in, m_out, FFTW_FORWARD);
+  m_inversePlan = plan(m_channelIn, m_channelOut, FFTW_BACKWARD);
+  Logger::info("channelizer", "init overlap-save, fft size: {}, output fft size: {}, overlap: {}, taps: {}", m_fftSize, m_outputFftSize, m_overlap, length);
+}
+
+OverlapSaveChannelizer::~OverlapSaveChannelizer() {
+  Logger::info("channelizer", "deinit overlap-save");
+  std::unique_lock<std::mutex> lock(fftwPlannerMutex());
+  fftwf_destroy_plan(m_forwardPlan);
+  fftwf_destroy_plan(m_inversePlan);
+}
+
+Channelizer::Channel OverlapSaveChannelizer::channel(int32_t frequency) const {
+  const auto index = std::lround(static_cast<double>(frequency) * m_fftSize / m_sampleRate);
+  const auto residual = frequency - std::lround(static_cast<double>(index) * m_sampleRate / m_fftSize);
+  return {static_cast<uint32_t>((index % m_fftSize + m_fftSize) % m_fftSize), static_cast<int32_t>(residual)};
+}
+
+Frequency OverlapSaveChannelizer::sampleRate() const { return m_sampleRate; }
+
+Frequency OverlapSaveChannelizer::outputSampleRate() const { return m_sampleRate / m_decimation; }
+
+uint32_t OverlapSaveChannelizer::workerDecimation() const { return 1; }
+
+uint32_t OverlapSaveChannelizer::outputSize(uint32_t inputSize) const { return (m_buffer.size() + inputSize - m_overlap) / m_step * (m_step / m_decimation); }
+
+// Taking the bins around the channel center mixes every block down as if it started at sample zero, the twiddle of
+// channel k for the block starting at absolute sample s restores the phase: exp(-2 pi j k s / fft size).
+void OverlapSaveChannelizer::process(const std::complex<float>* input, uint32_t size, const std::vector<uint32_t>& channels, const std::vector<std::complex<float>*>& outputs) {
+  const auto blockOutputs = m_step / m_decimation;
+  const auto firstOutput = m_overlap / m_decimation;
+  const auto halfSize = m_outputFftSize / 2;
+  const auto blocks = outputSize(size) / blockOutputs;
+  m_buffer.insert(m_buffer.end(), input, input + size);
+  for (uint32_t block = 0; block < blocks; ++block) {
+    std::copy(m_buffer.begin() + block * m_step, m_buffer.begin() + block * m_step + m_fftSize, m_in.begin());
+    fftwf_execute(m_forwardPlan);
+    for (uint32_t j = 0; j < channels.size(); ++j) {
+      const auto channel = channels[j];
+      auto bin = (channel + m_fftSize - halfSize) % m_fftSize;
+      for (uint32_t i = 0; i < m_outputFftSize; ++i) {
+        const auto target = (i + halfSize) % m_outputFftSize;
+        m_channelIn[target] = multiplyComplex(m_out[bin], m_response[target]);
+        bin = bin + 1 < m_fftSize ? bin + 1 : 0;
+      }
+      fftwf_execute(m_inversePlan);
+      const auto twiddle = m_twiddles[static_cast<uint64_t>(channel) * m_position % m_fftSize];
+      const auto output = outputs[j] + block * blockOutputs;
+      for (uint32_t i = 0; i < blockOutputs; ++i) {
+        output[i] = multiplyComplex(m_channelOut[firstOutput + i], twiddle);
+      }
+    }
+    m_position = (m_position + m_step) % m_fftSize;
+  }
+  m_buffer.erase(m_buffer.begin(), m_buffer.begin() + blocks * m_step);
+}
+
+// absolute index of the first block sample modulo fft size, the first block starts overlap samples before the input
+void OverlapSaveChannelizer::reset() {
+  m_buffer.assign(m_overlap, 0.0f);
+  m_position = (m_fftSize - m_overlap) % m_fftSize;
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <algorithms/channelizer.h>
+#include <config.h>
+#include <fftw3.h>
+#include <simd/aligned_allocator.h>
+
+// Fast convolution (overlap-save) filter bank. One large forward fft per block is shared by all channels, every channel
+// takes the bins around its center, weights them with the filter response and returns to the time domain with a small
+// inverse fft at the output rate, so the cost of a recording scales with its bandwidth. Channel k is centered at
+// k * sampleRate / fftSize, any frequency is within half a bin of a channel, and the whole decimation is done here.
+class OverlapSaveChannelizer : public Channelizer {
+ public:
+  OverlapSaveChannelizer(const Config& config, Frequency sampleRate, uint32_t decimation);
+  ~OverlapSaveChannelizer() override;
+
+  Channel channel(int32_t frequency) const override;
+  Frequency sampleRate() const override;
+  Frequency outputSampleRate() const override;
+  uint32_t workerDecimation() const override;
+  uint32_t outputSize(uint32_t inputSize) const override;
+  void process(const std::complex<float>* input, uint32_t size, const std::vector<uint32_t>& channels, const std::vector<std::complex<float>*>& outputs) override;
+  void reset() override;
+
+ private:
+  const Frequency m_sampleRate;
+  const uint32_t m_decimation;
+  uint32_t m_overlap;
+  uint32_t m_outputFftSize;
+  uint32_t m_fftSize;
+  uint32_t m_step;
+  AlignedVector<std::complex<float>> m_response;
+  AlignedVector<std::complex<float>> m_twiddles;
+  AlignedVector<std::complex<float>> m_buffer;
+  AlignedVector<std::complex<float>> m_in;
+  AlignedVector<std::complex<float>> m_out;
+  AlignedVector<std::complex<float>> m_channelIn;
+  AlignedVector<std::complex<float>> m_channelOut;
+  uint32_t m_position;
+  fftwf_plan m_forwardPlan;
+  fftwf_plan m_inversePlan;
+};
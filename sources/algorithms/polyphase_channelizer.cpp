@@ -0,0 +1,132 @@
+#include "polyphase_channelizer.h"
+
+#include <algorithms/fftw_initializer.h>
+#include <liquid/liquid.h>
+#include <logger.h>
+
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <numeric>
+
+constexpr auto CHANNELIZER_PASSBAND = 0.4f;
+constexpr auto CHANNELIZER_ATTENUATION = 60.0f;
+constexpr uint32_t CHANNELIZER_BATCH = 64;
+constexpr uint32_t CHANNELIZER_WORKER_DECIMATION = 4;
+constexpr uint32_t CHANNELIZER_OVERSAMPLING = 2;
+constexpr uint32_t CHANNELIZER_FULL_DECIMATION_OVERSAMPLING = 8;
+
+uint32_t channelizerDecimation(uint32_t decimation) {
+  for (auto d = decimation / CHANNELIZER_WORKER_DECIMATION; 1 < d; --d) {
+    if (decimation % d == 0) {
+      return d;
+    }
+  }
+  return decimation;
+}
+
+// Channels overlap, so any frequency is within a quarter of the channel rate from a channel center. Without worker
+// decimation the channel rate is the recording rate, there channels are packed denser to keep the residual small.
+PolyphaseChannelizer::PolyphaseChannelizer(const Config& config, Frequency sampleRate, uint32_t decimation)
+    : m_sampleRate(sampleRate),
+      m_decimation(channelizerDecimation(std::max(1u, decimation))),
+      m_workerDecimation(std::max(1u, decimation) / m_decimation),
+      m_channels(m_decimation * (1 < m_workerDecimation ? CHANNELIZER_OVERSAMPLING : CHANNELIZER_FULL_DECIMATION_OVERSAMPLING)),
+      m_twiddles(m_channels),
+      m_in(CHANNELIZER_BATCH * m_channels),
+      m_out(CHANNELIZER_BATCH * m_channels),
+      m_position(0) {
+  // passes the recording bandwidth around any frequency within half of the spacing from the channel center,
+  // and stops where the first image lands after decimation
+  const auto passband = CHANNELIZER_PASSBAND * config.minRecordingSampleRate() / sampleRate + 0.5f / m_channels;
+  const auto stopband = std::max(1.0f / m_decimation - passband, 1.5f * passband);
+  const auto length = estimate_req_filter_len(stopband - passband, CHANNELIZER_ATTENUATION);
+  std::vector<float> prototype(length);
+  liquid_firdes_kaiser(length, (passband + stopband) / 2.0f, CHANNELIZER_ATTENUATION, 0.0f, prototype.data());
+  const auto gain = std::accumulate(prototype.begin(), prototype.end(), 0.0f);
+
+  // reversed and padded with zeros to a multiple of channels, so a window of input is multiplied element-wise
+  m_taps = (length + m_channels - 1) / m_channels * m_channels;
+  m_filter.assign(m_taps, 0.0f);
+  for (uint32_t i = 0; i < length; ++i) {
+    m_filter[m_taps - 1 - i] = prototype[i] / gain;
+  }
+  for (uint32_t i = 0; i < m_channels; ++i) {
+    m_twiddles[i] = std::polar(1.0, -2.0 * M_PI * i / m_channels);
+  }
+  reset();
+
+  std::unique_lock<std::mutex> lock(fftwPlannerMutex());
+  const int size = m_channels;
+  auto in = reinterpret_cast<fftwf_complex*>(m_in.data());
+  auto out = reinterpret_cast<fftwf_complex*>(m_out.data());
+  const auto plannerFlags = fftwPlannerFlags(config.fftPlanner());
+  auto plan = [&](unsigned flags) { return fftwf_plan_many_dft(1, &size, CHANNELIZER_BATCH, in, nullptr, 1, size, out, nullptr, 1, size, FFTW_FORWARD, flags); };
+  m_plan = plan(plannerFlags | FFTW_WISDOM_ONLY);
+  if (!m_plan) {
+    m_plan = plan(plannerFlags);
+  }
+  Logger::info("channelizer", "init, channels: {}, decimation: {}, worker decimation: {}, taps: {}", m_channels, m_decimation, m_workerDecimation, m_taps);
+}
+
+PolyphaseChannelizer::~PolyphaseChannelizer() {
+  Logger::info("channelizer", "deinit");
+  std::unique_lock<std::mutex> lock(fftwPlannerMutex());
+  fftwf_destroy_plan(m_plan);
+}
+
+Channelizer::Channel PolyphaseChannelizer::channel(int32_t frequency) const {
+  const auto index = std::lround(static_cast<double>(frequency) * m_channels / m_sampleRate);
+  const auto residual = frequency - std::lround(static_cast<double>(index) * m_sampleRate / m_channels);
+  return {static_cast<uint32_t>((index % m_channels + m_channels) % m_channels), static_cast<int32_t>(residual)};
+}
+
+Frequency PolyphaseChannelizer::sampleRate() const { return m_sampleRate; }
+
+Frequency PolyphaseChannelizer::outputSampleRate() const { return m_sampleRate / m_decimation; }
+
+uint32_t PolyphaseChannelizer::workerDecimation() const { return m_workerDecimation; }
+
+uint32_t PolyphaseChannelizer::outputSize(uint32_t inputSize) const {
+  const auto size = m_buffer.size() + inputSize;
+  return size < m_taps ? 0 : (size - m_taps) / m_decimation + 1;
+}
+
+// Channel k of the window starting at absolute sample s is exp(-2 pi j k s / channels) * fft(fold(window))[k].
+void PolyphaseChannelizer::process(const std::complex<float>* input, uint32_t size, const std::vector<uint32_t>& channels, const std::vector<std::complex<float>*>& outputs) {
+  const auto frames = outputSize(size);
+  m_buffer.insert(m_buffer.end(), input, input + size);
+  for (uint32_t frame = 0; frame < frames; frame += CHANNELIZER_BATCH) {
+    const auto batch = std::min(CHANNELIZER_BATCH, frames - frame);
+    for (uint32_t i = 0; i < batch; ++i) {
+      fold(m_buffer.data() + (frame + i) * m_decimation, m_in.data() + i * m_channels);
+    }
+    fftwf_execute(m_plan);
+    for (uint32_t i = 0; i < batch; ++i) {
+      const auto spectrum = m_out.data() + i * m_channels;
+      for (uint32_t j = 0; j < channels.size(); ++j) {
+        const auto channel = channels[j];
+        outputs[j][frame + i] = spectrum[channel] * m_twiddles[channel * m_position % m_channels];
+      }
+      m_position = (m_position + m_decimation) % m_channels;
+    }
+  }
+  m_buffer.erase(m_buffer.begin(), m_buffer.begin() + frames * m_decimation);
+}
+
+// absolute index of the first window sample modulo channels, the window starts taps - 1 samples before the input
+void PolyphaseChannelizer::reset() {
+  m_buffer.assign(m_taps - 1, 0.0f);
+  m_position = 1 % m_channels;
+}
+
+void PolyphaseChannelizer::fold(const std::complex<float>* input, std::complex<float>* output) const {
+  std::fill(output, output + m_channels, std::complex<float>(0.0f, 0.0f));
+  for (uint32_t offset = 0; offset < m_taps; offset += m_channels) {
+    const auto samples = input + offset;
+    const auto filter = m_filter.data() + offset;
+    for (uint32_t i = 0; i < m_channels; ++i) {
+      output[i] += samples[i] * filter[i];
+    }
+  }
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <algorithms/channelizer.h>
+#include <config.h>
+#include <fftw3.h>
+#include <simd/aligned_allocator.h>
+
+// Oversampled polyphase fft filter bank. Splits the input into overlapping channels and decimates them in one pass,
+// so every recording of a chunk shares one filter and one small fft per output sample. Filter state carries over
+// between calls. Channel k is centered at k * sampleRate / channels, the distance of a requested frequency from its
+// channel center is returned as residual and left to the caller, as is the rest of the decimation (workerDecimation).
+class PolyphaseChannelizer : public Channelizer {
+ public:
+  // decimation is the total one, from sampleRate to the recording sample rate
+  PolyphaseChannelizer(const Config& config, Frequency sampleRate, uint32_t decimation);
+  ~PolyphaseChannelizer() override;
+
+  Channel channel(int32_t frequency) const override;
+  Frequency sampleRate() const override;
+  Frequency outputSampleRate() const override;
+  uint32_t workerDecimation() const override;
+  uint32_t outputSize(uint32_t inputSize) const override;
+  void process(const std::complex<float>* input, uint32_t size, const std::vector<uint32_t>& channels, const std::vector<std::complex<float>*>& outputs) override;
+  void reset() override;
+
+ private:
+  void fold(const std::complex<float>* input, std::complex<float>* output) const;
+
+  const Frequency m_sampleRate;
+  const uint32_t m_decimation;
+  const uint32_t m_workerDecimation;
+  const uint32_t m_channels;
+  uint32_t m_taps;
+  AlignedVector<float> m_filter;
+  AlignedVector<std::complex<float>> m_twiddles;
+  AlignedVector<std::complex<float>> m_buffer;
+  AlignedVector<std::complex<float>> m_in;
+  AlignedVector<std::complex<float>> m_out;
+  uint32_t m_position;
+  fftwf_plan m_plan;
+};
+
+// Part of the recording decimation done by the channelizer. The channel is left oversampled when possible, which
+// keeps the prototype filter short, the rest is decimated by recorder workers at the low channel rate.
+uint32_t channelizerDecimation(uint32_t decimation);
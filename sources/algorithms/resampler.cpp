@@ -0,0 +1,90 @@
+#include "resampler.h"
+
+#include <liquid/liquid.h>
+#include <logger.h>
+#include <simd/fir.h>
+
+#include <numeric>
+
+constexpr auto RESAMPLER_PASSBAND = 0.4f;
+constexpr auto RESAMPLER_ATTENUATION = 60.0f;
+constexpr uint32_t RESAMPLER_MAX_PHASES = 1024;
+
+ResamplingRatio resamplingRatio(Frequency sampleRate, uint32_t decimation, Frequency outputSampleRate) {
+  const auto interpolation = static_cast<uint64_t>(outputSampleRate) * decimation;
+  const auto gcd = std::gcd(interpolation, static_cast<uint64_t>(sampleRate));
+  return {static_cast<uint32_t>(interpolation / gcd), static_cast<uint32_t>(sampleRate / gcd)};
+}
+
+// The prototype runs at the rate of its phases, it passes the recording bandwidth of the lower of both rates and stops
+// before the first image or alias lands in it. Every phase is stored reversed and contiguous for a plain dot product.
+// Ratios of busy sample rates reduce to terms of several hundred thousand, designing all of their phases would take
+// millions of taps, so the phases are capped and the gain is summed in double.
+std::shared_ptr<const ResamplerFilter> resamplerFilter(const ResamplingRatio& ratio) {
+  auto filter = std::make_shared<ResamplerFilter>();
+  filter->phases = std::min(ratio.interpolation, RESAMPLER_MAX_PHASES);
+  const auto bandwidth = std::min(1.0f, static_cast<float>(ratio.interpolation) / ratio.decimation) / filter->phases;
+  const auto passband = RESAMPLER_PASSBAND * bandwidth;
+  const auto stopband = bandwidth - passband;
+  const auto length = estimate_req_filter_len(stopband - passband, RESAMPLER_ATTENUATION);
+  filter->phaseTaps = (length + filter->phases - 1) / filter->phases;
+  std::vector<float> prototype(filter->phaseTaps * filter->phases);
+  liquid_firdes_kaiser(prototype.size(), (passband + stopband) / 2.0f, RESAMPLER_ATTENUATION, 0.0f, prototype.data());
+  const auto gain = std::accumulate(prototype.begin(), prototype.end(), 0.0) / filter->phases;
+
+  filter->taps.resize((filter->phases + 1) * filter->phaseTaps);
+  for (uint32_t phase = 0; phase <= filter->phases; ++phase) {
+    for (uint32_t i = 0; i < filter->phaseTaps; ++i) {
+      const auto index = phase + i * filter->phases;
+      filter->taps[phase * filter->phaseTaps + filter->phaseTaps - 1 - i] = index < prototype.size() ? prototype[index] / gain : 0.0f;
+    }
+  }
+  Logger::debug("resampler", "filter, interpolation: {}, decimation: {}, phases: {}, phase taps: {}", ratio.interpolation, ratio.decimation, filter->phases, filter->phaseTaps);
+  return filter;
+}
+
+Resampler::Resampler(const ResamplingRatio& ratio) : Resampler(ratio, resamplerFilter(ratio)) {}
+
+Resampler::Resampler(const ResamplingRatio& ratio, std::shared_ptr<const ResamplerFilter> filter)
+    : m_interpolation(ratio.interpolation), m_decimation(ratio.decimation), m_filter(std::move(filter)), m_interpolatedTaps(m_filter->phaseTaps), m_phase(0), m_index(0) {
+  m_buffer.assign(m_filter->phaseTaps - 1, 0.0f);
+}
+
+uint32_t Resampler::maxOutputSize(uint32_t size) const { return static_cast<uint64_t>(size) * m_interpolation / m_decimation + 1; }
+
+void Resampler::reset() {
+  std::fill(m_buffer.begin(), m_buffer.end(), 0.0f);
+  m_phase = 0;
+  m_index = 0;
+}
+
+// taps of the exact phase, interpolated between the two nearest designed phases when the phases are capped
+const float* Resampler::phaseTaps() {
+  const auto position = static_cast<uint64_t>(m_phase) * m_filter->phases;
+  const auto phase = position / m_interpolation;
+  const auto fraction = static_cast<float>(position % m_interpolation) / m_interpolation;
+  const auto taps = m_filter->taps.data() + phase * m_filter->phaseTaps;
+  if (fraction == 0.0f) {
+    return taps;
+  }
+  const auto nextTaps = taps + m_filter->phaseTaps;
+  for (uint32_t i = 0; i < m_interpolatedTaps.size(); ++i) {
+    m_interpolatedTaps[i] = taps[i] + fraction * (nextTaps[i] - taps[i]);
+  }
+  return m_interpolatedTaps.data();
+}
+
+// m_index is the window start of the next output relative to the history start
+uint32_t Resampler::resample(const std::complex<float>* input, uint32_t size, std::complex<float>* output) {
+  m_buffer.insert(m_buffer.end(), input, input + size);
+  uint32_t count = 0;
+  while (m_index < size) {
+    fir(m_buffer.data() + m_index, phaseTaps(), m_filter->phaseTaps, 1, output + count++, 1);
+    m_phase += m_decimation;
+    m_index += m_phase / m_interpolation;
+    m_phase %= m_interpolation;
+  }
+  m_index -= size;
+  m_buffer.erase(m_buffer.begin(), m_buffer.begin() + size);
+  return count;
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <radio/help_structures.h>
+
+#include <complex>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+struct ResamplingRatio {
+  uint32_t interpolation;
+  uint32_t decimation;
+};
+
+// Reduced ratio which takes the rate sampleRate / decimation to exactly outputSampleRate.
+ResamplingRatio resamplingRatio(Frequency sampleRate, uint32_t decimation, Frequency outputSampleRate);
+
+// Polyphase prototype of a ratio. At most 1024 phases are designed, a finer phase is interpolated
+// linearly between its neighbours. The filter is immutable, so all resamplers of a ratio share one.
+struct ResamplerFilter {
+  uint32_t phases;
+  uint32_t phaseTaps;
+  // phases + 1 rows of reversed taps, the last row is the first phase one sample later
+  std::vector<float> taps;
+};
+
+std::shared_ptr<const ResamplerFilter> resamplerFilter(const ResamplingRatio& ratio);
+
+// Polyphase rational resampler, interpolates by one ratio term and decimates by the other in a single filter. Output k
+// is the dot product of phase (k * decimation) % interpolation with the samples ending at k * decimation / interpolation.
+// History and phase carry over between calls, so consecutive chunks are resampled as one continuous stream.
+class Resampler {
+ public:
+  explicit Resampler(const ResamplingRatio& ratio);
+  Resampler(const ResamplingRatio& ratio, std::shared_ptr<const ResamplerFilter> filter);
+
+  uint32_t maxOutputSize(uint32_t size) const;
+  // returns the number of written samples, at most maxOutputSize(size)
+  uint32_t resample(const std::complex<float>* input, uint32_t size, std::complex<float>* output);
+  // clears the history and phase, so the filter can be reused for another stream
+  void reset();
+
+ private:
+  const float* phaseTaps();
+
+  const uint32_t m_interpolation;
+  const uint32_t m_decimation;
+  const std::shared_ptr<const ResamplerFilter> m_filter;
+  std::vector<float> m_interpolatedTaps;
+  std::vector<std::complex<float>> m_buffer;
+  uint32_t m_phase;
+  uint64_t m_index;
+};
@@ -0,0 +1,63 @@
+#include "signal_generator.h"
+
+#include <logger.h>
+
+#include <algorithm>
+#include <cmath>
+
+constexpr auto FM_TONE_FREQUENCY = 1000.0;
+constexpr auto FM_DEVIATION = 5000.0;
+constexpr auto FULL_SCALE = 127.5f;
+
+SignalGenerator::SignalGenerator(const Config &config)
+    : m_transmissions(config.generatorTransmissions()), m_random(config.generatorSeed()), m_noise(0.0f, std::pow(10.0f, config.generatorNoise() / 20.0f) / std::sqrt(2.0f)) {
+  Logger::info("generator", "init, transmissions: {}, noise: {:.2f} dB, seed: {}", m_transmissions.size(), config.generatorNoise(), config.generatorSeed());
+  for (const auto &transmission : m_transmissions) {
+    Logger::debug(
+        "generator",
+        "transmission {}, power: {:.2f} dB, fm: {}, period: {} ms, duty cycle: {:.2f}",
+        frequencyToString(transmission.frequency),
+        transmission.power,
+        transmission.fm,
+        transmission.period.count(),
+        transmission.dutyCycle);
+  }
+}
+
+void SignalGenerator::generate(const FrequencyRange &frequencyRange, std::chrono::microseconds time, uint8_t *data, uint32_t size) {
+  const auto samplesCount = size / 2;
+  const auto sampleRate = static_cast<double>(frequencyRange.sampleRate);
+  const uint64_t firstIndex = time.count() * frequencyRange.sampleRate / 1000000;
+  m_buffer.assign(samplesCount, {0.0f, 0.0f});
+
+  for (const auto &transmission : m_transmissions) {
+    const auto offset = static_cast<double>(transmission.frequency) - static_cast<double>(frequencyRange.center());
+    if (sampleRate / 2 <= std::abs(offset)) {
+      continue;
+    }
+    const auto amplitude = std::pow(10.0, transmission.power / 20.0);
+    const uint64_t period = transmission.period.count() * frequencyRange.sampleRate / 1000;
+    const auto activePeriod = static_cast<uint64_t>(period * transmission.dutyCycle);
+    const auto startPhase = offset * (firstIndex / sampleRate);
+    auto phasor = std::polar(amplitude, 2.0 * M_PI * (startPhase - std::floor(startPhase)));
+    const auto step = std::polar(1.0, 2.0 * M_PI * offset / sampleRate);
+    for (uint32_t i = 0; i < samplesCount; ++i, phasor *= step) {
+      const auto index = firstIndex + i;
+      if (period != 0 && activePeriod <= index % period) {
+        continue;
+      }
+      if (transmission.fm) {
+        const auto modulation = FM_DEVIATION / FM_TONE_FREQUENCY * std::sin(2.0 * M_PI * FM_TONE_FREQUENCY * (index / sampleRate));
+        m_buffer[i] += std::complex<float>(phasor * std::polar(1.0, modulation));
+      } else {
+        m_buffer[i] += std::complex<float>(phasor);
+      }
+    }
+  }
+
+  auto toRaw = [](float value) { return static_cast<uint8_t>(std::clamp(std::lround(value * FULL_SCALE + FULL_SCALE), 0l, 255l)); };
+  for (uint32_t i = 0; i < samplesCount; ++i) {
+    data[2 * i] = toRaw(m_buffer[i].real() + m_noise(m_random));
+    data[2 * i + 1] = toRaw(m_buffer[i].imag() + m_noise(m_random));
+  }
+}
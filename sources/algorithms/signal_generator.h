@@ -0,0 +1,25 @@
+#pragma once
+
+#include <config.h>
+#include <radio/help_structures.h>
+
+#include <chrono>
+#include <complex>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+// Synthesizes cu8 samples with gaussian noise floor and configured carriers, bursts and FM transmissions.
+// Signals depend only on sample time, so consecutive calls are continuous and runs with the same seed are repeatable.
+class SignalGenerator {
+ public:
+  SignalGenerator(const Config& config);
+
+  void generate(const FrequencyRange& frequencyRange, std::chrono::microseconds time, uint8_t* data, uint32_t size);
+
+ private:
+  const GeneratorTransmissions m_transmissions;
+  std::mt19937 m_random;
+  std::normal_distribution<float> m_noise;
+  std::vector<std::complex<float>> m_buffer;
+};
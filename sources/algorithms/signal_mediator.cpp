@@ -6,34 +6,32 @@ SignalMediator::SignalMediator(std::chrono::milliseconds aggregationTime) : m_ag
   Logger::info("SignalMediator", "aggregation time: {} ms", m_aggregationTime.count());
 }
 
-std::vector<Signal> SignalMediator::append(const std::chrono::milliseconds time, const std::vector<Signal>& signals) {
-  if (m_signals.size() < signals.size()) {
+std::optional<Spectrum> SignalMediator::append(const std::chrono::milliseconds time, const Spectrum& spectrum) {
+  if (!m_spectrum || m_spectrum->size() < spectrum.size()) {
     m_firstSamplesTime = time;
     m_samplesCount = 0;
-    m_signals.clear();
-    m_signals.reserve(signals.size());
-    for (const auto& signal : signals) {
-      m_signals.push_back({signal.frequency, 0.0f});
-    }
+    m_spectrum.emplace(spectrum.frequencyRange());
   }
 
-  std::vector<Signal> averagedSignals;
+  const auto sum = m_spectrum->data();
+  std::optional<Spectrum> averagedSpectrum;
   if (m_firstSamplesTime + m_aggregationTime <= time) {
-    averagedSignals = m_signals;
-    for (auto& signal : m_signals) {
-      signal.power = 0.0f;
-    }
-    for (auto& signal : averagedSignals) {
-      signal.power /= m_samplesCount;
+    averagedSpectrum.emplace(m_spectrum->frequencyRange());
+    const auto averaged = averagedSpectrum->data();
+    const auto scale = 1.0f / m_samplesCount;
+    for (uint32_t i = 0; i < m_spectrum->size(); ++i) {
+      averaged[i] = sum[i] * scale;
+      sum[i] = 0.0f;
     }
     m_firstSamplesTime = time;
     m_samplesCount = 0;
   }
 
   m_samplesCount++;
-  for (uint32_t i = 0; i < signals.size(); ++i) {
-    m_signals[i].power += signals[i].power;
+  const auto power = spectrum.data();
+  for (uint32_t i = 0; i < spectrum.size(); ++i) {
+    sum[i] += power[i];
   }
 
-  return averagedSignals;
+  return averagedSpectrum;
 }
@@ -4,17 +4,17 @@
 #include <stdint.h>
 
 #include <chrono>
-#include <vector>
+#include <optional>
 
 class SignalMediator {
  public:
   SignalMediator(std::chrono::milliseconds aggregationTime);
 
-  std::vector<Signal> append(const std::chrono::milliseconds sampleTime, const std::vector<Signal>& signals);
+  std::optional<Spectrum> append(const std::chrono::milliseconds sampleTime, const Spectrum& spectrum);
 
  private:
   const std::chrono::milliseconds m_aggregationTime;
-  std::vector<Signal> m_signals;
+  std::optional<Spectrum> m_spectrum;
   std::chrono::milliseconds m_firstSamplesTime;
   uint32_t m_samplesCount;
 };
@@ -2,50 +2,84 @@
 
 #include <fftw3.h>
 #include <logger.h>
+#include <simd/decibels.h>
 
+#include <algorithm>
 #include <cmath>
 #include <complex>
 
-Spectrogram::Spectrogram(const Config& config) : m_config(config) { Logger::info("spectrogram", "init"); }
+constexpr auto MAX_WELCH_OVERLAP = 0.95f;
+
+Spectrogram::Spectrogram(const Config& config) : m_config(config), m_shiftOffset(0), m_shiftSampleRate(0) { Logger::info("spectrogram", "init"); }
 
 Spectrogram::~Spectrogram() { Logger::info("spectrogram", "deinit"); }
 
-std::vector<Signal> Spectrogram::psd(const FrequencyRange& frequencyRange, std::complex<float>* data, const uint32_t dataSize) {
+Spectrum Spectrogram::psd(const FrequencyRange& frequencyRange, std::complex<float>* data, const uint32_t dataSize) {
+  return psd(frequencyRange, dataSize, [data](Fft& fft, uint32_t stride) { return fft.compute(data, stride); });
+}
+
+// dataSize is in samples. The shift phase does not change fft magnitudes, so a single table of the fft length
+// is reused for every frame.
+Spectrum Spectrogram::psd(const FrequencyRange& frequencyRange, const uint8_t* data, const uint32_t dataSize, SampleFormat format, int32_t frequencyOffset) {
+  const auto windowSize = frequencyRange.fft;
+  if (frequencyOffset != 0 && (m_shiftData.size() != windowSize || m_shiftOffset != frequencyOffset || m_shiftSampleRate != frequencyRange.sampleRate)) {
+    m_shiftData.assign(windowSize, 1.0f);
+    Nco(frequencyOffset, frequencyRange.sampleRate).mix(m_shiftData.data(), windowSize);
+    m_shiftOffset = frequencyOffset;
+    m_shiftSampleRate = frequencyRange.sampleRate;
+  }
+  const auto shift = frequencyOffset != 0 ? m_shiftData.data() : nullptr;
+  return psd(frequencyRange, dataSize, [data, format, shift](Fft& fft, uint32_t stride) { return fft.compute(data, stride, shift, format); });
+}
+
+// Welch frames are spread evenly over the chunk, so short bursts anywhere in it are seen. Their count follows the budget
+// (ffts per chunk length in fft sizes), limited by the max overlap, frames never start closer than fftSize * (1 - overlap).
+// Below that limit frames overlap less or leave gaps between them.
+std::pair<uint32_t, uint32_t> Spectrogram::welchFrames(const uint32_t fftSize, const uint32_t dataSize) const {
+  if (dataSize <= fftSize) {
+    return {1, fftSize};
+  }
+  const auto overlap = std::clamp(m_config.welchMaxOverlap(), 0.0f, MAX_WELCH_OVERLAP);
+  const auto hop = std::max(1u, static_cast<uint32_t>(std::lround(fftSize * (1.0f - overlap))));
+  const auto maxFrames = (dataSize - fftSize) / hop + 1;
+  const auto budgetFrames = static_cast<uint32_t>(std::lround(m_config.welchBudget() * dataSize / fftSize));
+  const auto frames = std::clamp(budgetFrames, 1u, maxFrames);
+  return {frames, frames == 1 ? fftSize : (dataSize - fftSize) / (frames - 1)};
+}
+
+template <typename Compute>
+Spectrum Spectrogram::psd(const FrequencyRange& frequencyRange, const uint32_t dataSize, Compute compute) {
   const auto fftSize = frequencyRange.fft;
-  const auto iterations = std::max(1u, static_cast<uint32_t>(std::lround((dataSize / fftSize) * m_config.spectrogramFactor())));
+  const auto [iterations, stride] = welchFrames(fftSize, dataSize);
 
   if (m_buffer.size() < fftSize) {
     m_buffer.resize(fftSize);
   }
-  if (m_fft.count(fftSize) == 0) {
-    m_fft[fftSize] = std::make_unique<Fft>(fftSize, fftSize / 2);
+  auto& fft = m_fft[{fftSize, iterations}];
+  if (!fft) {
+    fft = std::make_unique<Fft>(fftSize, fftSize, iterations, fftwPlannerFlags(m_config.fftPlanner()));
   }
 
+  // power is averaged over frames, |X|^2 is accumulated directly instead of squaring the averaged |X|
   memset(m_buffer.data(), 0, fftSize * sizeof(float));
-  auto& fft = m_fft[fftSize];
+  const auto result = compute(*fft, stride);
   for (uint32_t i = 0; i < iterations; ++i) {
-    auto result = fft->compute(data + i * fftSize);
+    const auto frame = result + i * fftSize;
     for (uint32_t j = 0; j < fftSize; ++j) {
-      m_buffer[j] += std::abs(result[j]);
+      m_buffer[j] += frame[j].real() * frame[j].real() + frame[j].imag() * frame[j].imag();
     }
   }
 
-  const auto centerFrequency = frequencyRange.center();
-  const auto sampleRate = frequencyRange.sampleRate;
-  const auto factor = static_cast<uint64_t>(frequencyRange.sampleRate);
-
-  std::vector<Signal> signals;
-  signals.reserve(fftSize);
-  for (uint32_t i = 0; i < fftSize; ++i) {
-    const auto frequency = (centerFrequency - sampleRate / 2) + static_cast<uint64_t>(i) * sampleRate / fftSize;
-    if (frequencyRange.start <= frequency && frequency <= frequencyRange.stop) {
-      const auto powerIndex = (i + fftSize / 2) % fftSize;
-      const auto power = 10.0f * std::log10(std::pow(m_buffer[powerIndex] / iterations, 2.0f) / factor);
-      signals.push_back({static_cast<Frequency>(frequency), power});
-    }
-  }
-  if (signals.back().frequency != frequencyRange.stop) {
-    signals.push_back({frequencyRange.stop, signals.back().power});
+  // fft output starts at the center frequency, bins are rotated by half of the fft size while converting to dB
+  const auto scale = 1.0f / (iterations * static_cast<float>(frequencyRange.sampleRate) * fft->windowPower());
+  Spectrum spectrum(frequencyRange);
+  const auto bins = spectrum.bins();
+  const auto shifted = (spectrum.firstBin() + fftSize / 2) % fftSize;
+  const auto head = std::min(bins, fftSize - shifted);
+  toDecibels(m_buffer.data() + shifted, spectrum.data(), head, scale);
+  toDecibels(m_buffer.data(), spectrum.data() + head, bins - head, scale);
+  if (bins < spectrum.size()) {
+    spectrum[bins] = spectrum[bins - 1];
   }
-  return signals;
+  return spectrum;
 }
@@ -1,10 +1,13 @@
 #pragma once
 
 #include <algorithms/fft.h>
+#include <algorithms/fftw_initializer.h>
+#include <algorithms/nco.h>
 #include <config.h>
 #include <utils.h>
 
 #include <complex>
+#include <map>
 #include <vector>
 
 class Spectrogram {
@@ -12,10 +15,18 @@ class Spectrogram {
   Spectrogram(const Config& config);
   virtual ~Spectrogram();
 
-  std::vector<Signal> psd(const FrequencyRange& frequencyRange, std::complex<float>* data, const uint32_t dataSize);
+  Spectrum psd(const FrequencyRange& frequencyRange, std::complex<float>* data, const uint32_t dataSize);
+  Spectrum psd(const FrequencyRange& frequencyRange, const uint8_t* data, const uint32_t dataSize, SampleFormat format, int32_t frequencyOffset);
 
  private:
+  std::pair<uint32_t, uint32_t> welchFrames(const uint32_t fftSize, const uint32_t dataSize) const;
+  template <typename Compute>
+  Spectrum psd(const FrequencyRange& frequencyRange, const uint32_t dataSize, Compute compute);
+
   const Config& m_config;
   std::vector<float> m_buffer;
-  std::unordered_map<uint32_t, std::unique_ptr<Fft>> m_fft;
+  std::vector<std::complex<float>> m_shiftData;
+  int32_t m_shiftOffset;
+  Frequency m_shiftSampleRate;
+  std::map<std::pair<uint32_t, uint32_t>, std::unique_ptr<Fft>> m_fft;
 };
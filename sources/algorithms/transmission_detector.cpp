@@ -10,14 +10,14 @@ TransmissionDetector::TransmissionDetector(const Config& config) : m_config(conf
 
 TransmissionDetector::~TransmissionDetector() = default;
 
-std::vector<std::pair<FrequencyRange, bool>> TransmissionDetector::getTransmissions(const std::chrono::milliseconds& time, const std::vector<Signal>& signals) {
+std::vector<std::pair<FrequencyRange, bool>> TransmissionDetector::getTransmissions(const std::chrono::milliseconds& time, const Spectrum& spectrum) {
   std::unique_lock lock(m_mutex);
   m_tornTransmissionDetector.update(time);
-  updateTransmissionLastSignalTime(time, m_noiseLearner.getStrongSignals(signals));
-  const auto start = getTransmission(signals.front().frequency);
-  const auto stop = getTransmission(signals.back().frequency);
+  updateTransmissionLastSignalTime(time, m_noiseLearner.getStrongSignals(spectrum));
+  const auto start = getTransmission(spectrum.frequency(0));
+  const auto stop = getTransmission(spectrum.frequency(spectrum.size() - 1));
   const auto transmissions = getTransmissionWithActiveFlag(time, start, stop);
-  m_noiseLearner.update(signals, transmissions);
+  m_noiseLearner.update(spectrum, transmissions);
   return transmissions;
 }
 
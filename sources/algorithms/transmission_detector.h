@@ -15,7 +15,7 @@ class TransmissionDetector {
   TransmissionDetector(const Config& config);
   ~TransmissionDetector();
 
-  std::vector<std::pair<FrequencyRange, bool>> getTransmissions(const std::chrono::milliseconds& time, const std::vector<Signal>& signals);
+  std::vector<std::pair<FrequencyRange, bool>> getTransmissions(const std::chrono::milliseconds& time, const Spectrum& spectrum);
 
  private:
   void updateTransmissionLastSignalTime(const std::chrono::milliseconds& time, std::vector<Signal>&& signals);
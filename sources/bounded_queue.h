@@ -0,0 +1,76 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <optional>
+
+// Blocking queue with fixed capacity, push() waits while the queue is full and pop() while it is empty, tryPush() fails instead.
+// After close() push() fails immediately and pop() returns remaining values, then std::nullopt.
+template <typename T>
+class BoundedQueue {
+ public:
+  BoundedQueue(uint32_t capacity) : m_capacity(capacity), m_isClosed(false) {}
+
+  bool push(T&& value) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_notFull.wait(lock, [this]() { return m_isClosed || m_queue.size() < m_capacity; });
+    if (m_isClosed) {
+      return false;
+    }
+    m_queue.push_back(std::move(value));
+    m_notEmpty.notify_one();
+    return true;
+  }
+
+  bool tryPush(T&& value) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_isClosed || m_capacity <= m_queue.size()) {
+      return false;
+    }
+    m_queue.push_back(std::move(value));
+    m_notEmpty.notify_one();
+    return true;
+  }
+
+  std::optional<T> pop() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_notEmpty.wait(lock, [this]() { return m_isClosed || !m_queue.empty(); });
+    if (m_queue.empty()) {
+      return std::nullopt;
+    }
+    std::optional<T> value(std::move(m_queue.front()));
+    m_queue.pop_front();
+    m_notFull.notify_one();
+    return value;
+  }
+
+  void clear() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_queue.clear();
+    m_notFull.notify_all();
+  }
+
+  void close() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_isClosed = true;
+    m_notFull.notify_all();
+    m_notEmpty.notify_all();
+  }
+
+  uint32_t size() const {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    return m_queue.size();
+  }
+
+  uint32_t capacity() const { return m_capacity; }
+
+ private:
+  const uint32_t m_capacity;
+  mutable std::mutex m_mutex;
+  std::condition_variable m_notFull;
+  std::condition_variable m_notEmpty;
+  std::deque<T> m_queue;
+  bool m_isClosed;
+};
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <logger.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Pool of reusable buffers handed out as reference-counted handles. A buffer returns to the pool when its
+// last handle is dropped, so in steady state acquiring a buffer does not allocate. The pool must outlive its buffers.
+template <typename T>
+class BufferPool {
+  struct Slot {
+    BufferPool* pool;
+    std::vector<T> data;
+    uint32_t size;
+    std::atomic_uint32_t references;
+  };
+
+ public:
+  class Buffer {
+   public:
+    Buffer() : m_slot(nullptr) {}
+    Buffer(const Buffer& other) : m_slot(other.m_slot) {
+      if (m_slot) {
+        m_slot->references.fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+    Buffer(Buffer&& other) noexcept : m_slot(other.m_slot) { other.m_slot = nullptr; }
+    ~Buffer() { reset(); }
+
+    Buffer& operator=(const Buffer& other) {
+      if (this != &other) {
+        Buffer tmp(other);
+        std::swap(m_slot, tmp.m_slot);
+      }
+      return *this;
+    }
+    Buffer& operator=(Buffer&& other) noexcept {
+      if (this != &other) {
+        reset();
+        std::swap(m_slot, other.m_slot);
+      }
+      return *this;
+    }
+
+    T* data() const { return m_slot ? m_slot->data.data() : nullptr; }
+    uint32_t size() const { return m_slot ? m_slot->size : 0; }
+    T* begin() const { return data(); }
+    T* end() const { return data() + size(); }
+    explicit operator bool() const { return m_slot != nullptr; }
+
+    void reset() {
+      if (m_slot && m_slot->references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        m_slot->pool->release(m_slot);
+      }
+      m_slot = nullptr;
+    }
+
+   private:
+    friend class BufferPool;
+    explicit Buffer(Slot* slot) : m_slot(slot) {}
+
+    Slot* m_slot;
+  };
+
+  BufferPool(const std::string& name, uint32_t buffersCount) : m_name(name) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (uint32_t i = 0; i < buffersCount; ++i) {
+      allocate();
+    }
+  }
+
+  Buffer acquire(uint32_t size) {
+    Slot* slot = nullptr;
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      if (m_free.empty()) {
+        allocate();
+        Logger::warn(m_name.c_str(), "pool exhausted, buffers: {}", m_slots.size());
+      }
+      slot = m_free.back();
+      m_free.pop_back();
+    }
+    if (slot->data.size() < size) {
+      slot->data.resize(size);
+      Logger::debug(m_name.c_str(), "buffer resized, size: {}", size);
+    }
+    slot->size = size;
+    slot->references.store(1, std::memory_order_relaxed);
+    return Buffer(slot);
+  }
+
+  uint32_t buffersCount() const {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    return m_slots.size();
+  }
+
+  uint32_t freeBuffersCount() const {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    return m_free.size();
+  }
+
+ private:
+  void allocate() {
+    auto slot = std::make_unique<Slot>();
+    slot->pool = this;
+    slot->size = 0;
+    slot->references = 0;
+    m_free.reserve(m_slots.size() + 1);
+    m_free.push_back(slot.get());
+    m_slots.push_back(std::move(slot));
+  }
+
+  void release(Slot* slot) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_free.push_back(slot);
+  }
+
+  const std::string m_name;
+  mutable std::mutex m_mutex;
+  std::vector<std::unique_ptr<Slot>> m_slots;
+  std::vector<Slot*> m_free;
+};
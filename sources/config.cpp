@@ -2,10 +2,6 @@
 
 #include <logger.h>
 
-// experts only
-constexpr auto RESAMPLER_FILTER_LENGTH = 1;
-constexpr auto SPECTROGAM_FACTOR = 0.1f;
-
 std::string UserDefinedFrequencyRange::toString() const {
   return frequencyToString(start, "start") + ", " + frequencyToString(stop, "stop") + ", " + frequencyToString(sampleRate, "sample rate") + ", fft: " + std::to_string(fft);
 }
@@ -152,6 +148,49 @@ IgnoredFrequencies parseIgnoredFrequencies(const Config::InternalJson &json, con
   }
 }
 
+GeneratorTransmissions parseGeneratorTransmissions(const nlohmann::json &json) {
+  if (!json.contains("devices") || !json["devices"].contains("generator") || !json["devices"]["generator"].contains("transmissions")) {
+    throw std::runtime_error("parseGeneratorTransmissions exception: empty value");
+  }
+  GeneratorTransmissions transmissions;
+  for (const nlohmann::json &value : json["devices"]["generator"]["transmissions"]) {
+    const auto frequency = value["frequency"].get<Frequency>();
+    const auto power = value.contains("power") ? value["power"].get<float>() : -20.0f;
+    const auto fm = value.contains("modulation") && value["modulation"].get<std::string>() == "fm";
+    const auto period = std::chrono::milliseconds(value.contains("period_ms") ? value["period_ms"].get<uint32_t>() : 0);
+    const auto dutyCycle = value.contains("duty_cycle") ? value["duty_cycle"].get<float>() : 1.0f;
+    const auto count = value.contains("count") ? value["count"].get<uint32_t>() : 1;
+    const auto spacing = value.contains("spacing") ? value["spacing"].get<Frequency>() : 0;
+    for (uint32_t i = 0; i < count; ++i) {
+      transmissions.push_back({frequency + i * spacing, power, fm, period, dutyCycle});
+    }
+  }
+  return transmissions;
+}
+
+GeneratorTransmissions parseGeneratorTransmissions(const Config::InternalJson &json) {
+  try {
+    return parseGeneratorTransmissions(json.masterJson);
+  } catch (const std::exception &) {
+    try {
+      return parseGeneratorTransmissions(json.slaveJson);
+    } catch (const std::exception &) {
+      const auto hasGenerator = [](const nlohmann::json &json) { return json.contains("devices") && json["devices"].contains("generator"); };
+      if (hasGenerator(json.masterJson) || hasGenerator(json.slaveJson)) {
+        Logger::warn("config", "can not read: devices.generator.transmissions");
+      }
+      return {};
+    }
+  }
+}
+
+static std::string validateSweepMode(const std::string &sweepMode) {
+  if (sweepMode != "ordered" && sweepMode != "activity") {
+    throw std::runtime_error("invalid detection.sweep_mode: " + sweepMode + ", expected ordered or activity");
+  }
+  return sweepMode;
+}
+
 Config::Config(const std::string &path, const std::string &config)
     : m_json(getInternalJson(path, config)),
       m_userDefinedFrequencyRanges(parseFrequenciesRanges(m_json, "scanner_frequencies_ranges")),
@@ -159,20 +198,38 @@ Config::Config(const std::string &path, const std::string &config)
       m_maxRecordingNoiseTime(std::chrono::milliseconds(readKey(m_json, {"recording", "max_noise_time_ms"}, 2000))),
       m_minRecordingTime(std::chrono::milliseconds(readKey(m_json, {"recording", "min_time_ms"}, 1000))),
       m_minRecordingSampleRate(readKey(m_json, {"recording", "min_sample_rate"}, 64000)),
+      m_maxConcurrentRecordings(readKey(m_json, {"recording", "max_concurrent"}, 32)),
+      m_recordingChannelizer(readKey(m_json, {"recording", "channelizer"}, std::string("polyphase"))),
       m_frequencyGroupingSize(readKey(m_json, {"detection", "frequency_grouping_size"}, 10000)),
       m_frequencyRangeScanningTime(std::chrono::milliseconds(readKey(m_json, {"detection", "frequency_range_scanning_time_ms"}, 100))),
       m_noiseLearningTime(std::chrono::seconds(readKey(m_json, {"detection", "noise_learning_time_seconds"}, 10))),
       m_noiseDetectionMargin(readKey(m_json, {"detection", "noise_detection_margin"}, 10)),
       m_tornTransmissionLearningTime(std::chrono::seconds(readKey(m_json, {"detection", "torn_transmission_learning_time_seconds"}, 60))),
+      m_sweepMode(validateSweepMode(readKey(m_json, {"detection", "sweep_mode"}, std::string("ordered")))),
+      m_maxRevisitInterval(std::chrono::milliseconds(readKey(m_json, {"detection", "max_revisit_interval_ms"}, 0))),
+      m_fftPlanner(readKey(m_json, {"detection", "fft_planner"}, std::string("estimate"))),
+      m_welchMaxOverlap(readKey(m_json, {"detection", "welch_max_overlap"}, 0.5f)),
+      m_welchBudget(readKey(m_json, {"detection", "welch_budget"}, 0.1f)),
       m_logsDirectory(readKey(m_json, {"output", "logs"}, std::string("sdr/logs"))),
       m_consoleLogLevel(parseLogLevel(readKey(m_json, {"output", "console_log_level"}, std::string("info")))),
       m_fileLogLevel(parseLogLevel(readKey(m_json, {"output", "file_log_level"}, std::string("info")))),
+      m_fftwWisdomPath(readKey(m_json, {"output", "fftw_wisdom"}, std::string("sdr/fftw_wisdom"))),
       m_rtlSdrPpm(readKey(m_json, {"devices", "rtl_sdr", "ppm_error"}, 0)),
       m_rtlSdrGain(readKey(m_json, {"devices", "rtl_sdr", "tuner_gain"}, 0.0)),
       m_rtlSdrRadioOffset(readKey(m_json, {"devices", "rtl_sdr", "offset"}, 0)),
       m_hackRfLnaGain(readKey(m_json, {"devices", "hack_rf", "lna_gain"}, 0)),
       m_hackRfVgaGain(readKey(m_json, {"devices", "hack_rf", "vga_gain"}, 0)),
       m_hackRfRadioOffset(readKey(m_json, {"devices", "hack_rf", "offset"}, 0)),
+      m_replayPath(readKey(m_json, {"devices", "replay", "path"}, std::string(""))),
+      m_replayRealtime(readKey(m_json, {"devices", "replay", "realtime"}, true)),
+      m_replayLoop(readKey(m_json, {"devices", "replay", "loop"}, false)),
+      m_replayFrequency(readKey(m_json, {"devices", "replay", "frequency"}, 0)),
+      m_replaySampleRate(readKey(m_json, {"devices", "replay", "sample_rate"}, 0)),
+      m_generatorEnabled(readKey(m_json, {"devices", "generator", "enabled"}, false)),
+      m_generatorRealtime(readKey(m_json, {"devices", "generator", "realtime"}, true)),
+      m_generatorSeed(readKey(m_json, {"devices", "generator", "seed"}, 0)),
+      m_generatorNoise(readKey(m_json, {"devices", "generator", "noise"}, -30.0)),
+      m_generatorTransmissions(parseGeneratorTransmissions(m_json)),
       m_cores(readKey(m_json, {"cores"}, 4)),
       m_memoryLimit(readKey(m_json, {"memory_limit_mb"}, 0)),
       m_mqttHostname(readKey(m_json, {"mqtt", "hostname"}, std::string(""))),
@@ -198,16 +255,24 @@ IgnoredFrequencies Config::ignoredFrequencyRanges() const { return m_ignoredFreq
 std::chrono::milliseconds Config::maxRecordingNoiseTime() const { return m_maxRecordingNoiseTime; }
 std::chrono::milliseconds Config::minRecordingTime() const { return m_minRecordingTime; }
 Frequency Config::minRecordingSampleRate() const { return m_minRecordingSampleRate; }
+uint32_t Config::maxConcurrentRecordings() const { return m_maxConcurrentRecordings; }
+std::string Config::recordingChannelizer() const { return m_recordingChannelizer; }
 
 std::chrono::milliseconds Config::frequencyRangeScanningTime() const { return m_frequencyRangeScanningTime; }
 Frequency Config::frequencyGroupingSize() const { return m_frequencyGroupingSize; }
 std::chrono::seconds Config::noiseLearningTime() const { return m_noiseLearningTime; }
 uint32_t Config::noiseDetectionMargin() const { return m_noiseDetectionMargin; }
 std::chrono::seconds Config::tornTransmissionLearningTime() const { return m_tornTransmissionLearningTime; }
+std::string Config::sweepMode() const { return m_sweepMode; }
+std::chrono::milliseconds Config::maxRevisitInterval() const { return m_maxRevisitInterval; }
+std::string Config::fftPlanner() const { return m_fftPlanner; }
+float Config::welchMaxOverlap() const { return m_welchMaxOverlap; }
+float Config::welchBudget() const { return m_welchBudget; }
 
 spdlog::level::level_enum Config::logLevelFile() const { return m_fileLogLevel; }
 spdlog::level::level_enum Config::logLevelConsole() const { return m_consoleLogLevel; }
 std::string Config::logDir() const { return m_logsDirectory; }
+std::string Config::fftwWisdomPath() const { return m_fftwWisdomPath; }
 
 uint32_t Config::rtlSdrPpm() const { return m_rtlSdrPpm; }
 float Config::rtlSdrGain() const { return m_rtlSdrGain; }
@@ -217,6 +282,18 @@ uint32_t Config::hackRfLnaGain() const { return m_hackRfLnaGain; }
 uint32_t Config::hackRfVgaGain() const { return m_hackRfVgaGain; }
 int32_t Config::hackRfOffset() const { return m_hackRfRadioOffset; }
 
+std::string Config::replayPath() const { return m_replayPath; }
+bool Config::replayRealtime() const { return m_replayRealtime; }
+bool Config::replayLoop() const { return m_replayLoop; }
+Frequency Config::replayFrequency() const { return m_replayFrequency; }
+Frequency Config::replaySampleRate() const { return m_replaySampleRate; }
+
+bool Config::generatorEnabled() const { return m_generatorEnabled; }
+bool Config::generatorRealtime() const { return m_generatorRealtime; }
+uint32_t Config::generatorSeed() const { return m_generatorSeed; }
+float Config::generatorNoise() const { return m_generatorNoise; }
+GeneratorTransmissions Config::generatorTransmissions() const { return m_generatorTransmissions; }
+
 uint8_t Config::cores() const { return std::max(uint8_t(1), m_cores); }
 uint64_t Config::memoryLimit() const { return m_memoryLimit; }
 
@@ -224,6 +301,3 @@ std::string Config::mqttHostname() const { return m_mqttHostname; }
 int Config::mqttPort() const { return m_mqttPort; }
 std::string Config::mqttUsername() const { return m_mqttUsername; }
 std::string Config::mqttPassword() const { return m_mqttPassword; }
-
-uint32_t Config::resamplerFilterLength() const { return RESAMPLER_FILTER_LENGTH; }
-float Config::spectrogramFactor() const { return SPECTROGAM_FACTOR; }
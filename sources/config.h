@@ -22,6 +22,16 @@ struct UserDefinedFrequencyRanges {
 
 using IgnoredFrequencies = std::vector<FrequencyRange>;
 
+struct GeneratorTransmission {
+  const Frequency frequency;
+  const float power;
+  const bool fm;
+  const std::chrono::milliseconds period;
+  const float dutyCycle;
+};
+
+using GeneratorTransmissions = std::vector<GeneratorTransmission>;
+
 class Config {
  public:
   struct InternalJson {
@@ -38,16 +48,24 @@ class Config {
   std::chrono::milliseconds maxRecordingNoiseTime() const;
   std::chrono::milliseconds minRecordingTime() const;
   Frequency minRecordingSampleRate() const;
+  uint32_t maxConcurrentRecordings() const;
+  std::string recordingChannelizer() const;
 
   Frequency frequencyGroupingSize() const;
   std::chrono::milliseconds frequencyRangeScanningTime() const;
   std::chrono::seconds noiseLearningTime() const;
   uint32_t noiseDetectionMargin() const;
   std::chrono::seconds tornTransmissionLearningTime() const;
+  std::string sweepMode() const;
+  std::chrono::milliseconds maxRevisitInterval() const;
+  std::string fftPlanner() const;
+  float welchMaxOverlap() const;
+  float welchBudget() const;
 
   spdlog::level::level_enum logLevelConsole() const;
   spdlog::level::level_enum logLevelFile() const;
   std::string logDir() const;
+  std::string fftwWisdomPath() const;
 
   uint32_t rtlSdrPpm() const;
   float rtlSdrGain() const;
@@ -57,6 +75,18 @@ class Config {
   uint32_t hackRfVgaGain() const;
   int32_t hackRfOffset() const;
 
+  std::string replayPath() const;
+  bool replayRealtime() const;
+  bool replayLoop() const;
+  Frequency replayFrequency() const;
+  Frequency replaySampleRate() const;
+
+  bool generatorEnabled() const;
+  bool generatorRealtime() const;
+  uint32_t generatorSeed() const;
+  float generatorNoise() const;
+  GeneratorTransmissions generatorTransmissions() const;
+
   uint8_t cores() const;
   uint64_t memoryLimit() const;
 
@@ -65,10 +95,6 @@ class Config {
   std::string mqttUsername() const;
   std::string mqttPassword() const;
 
-  // experts only
-  uint32_t resamplerFilterLength() const;
-  float spectrogramFactor() const;
-
  private:
   const InternalJson m_json;
 
@@ -78,16 +104,24 @@ class Config {
   const std::chrono::milliseconds m_maxRecordingNoiseTime;
   const std::chrono::milliseconds m_minRecordingTime;
   const Frequency m_minRecordingSampleRate;
+  const uint32_t m_maxConcurrentRecordings;
+  const std::string m_recordingChannelizer;
 
   const Frequency m_frequencyGroupingSize;
   const std::chrono::milliseconds m_frequencyRangeScanningTime;
   const std::chrono::seconds m_noiseLearningTime;
   const uint32_t m_noiseDetectionMargin;
   const std::chrono::seconds m_tornTransmissionLearningTime;
+  const std::string m_sweepMode;
+  const std::chrono::milliseconds m_maxRevisitInterval;
+  const std::string m_fftPlanner;
+  const float m_welchMaxOverlap;
+  const float m_welchBudget;
 
   const std::string m_logsDirectory;
   const spdlog::level::level_enum m_consoleLogLevel;
   const spdlog::level::level_enum m_fileLogLevel;
+  const std::string m_fftwWisdomPath;
 
   const uint32_t m_rtlSdrPpm;
   const float m_rtlSdrGain;
@@ -97,6 +131,18 @@ class Config {
   const uint32_t m_hackRfVgaGain;
   const int32_t m_hackRfRadioOffset;
 
+  const std::string m_replayPath;
+  const bool m_replayRealtime;
+  const bool m_replayLoop;
+  const Frequency m_replayFrequency;
+  const Frequency m_replaySampleRate;
+
+  const bool m_generatorEnabled;
+  const bool m_generatorRealtime;
+  const uint32_t m_generatorSeed;
+  const float m_generatorNoise;
+  const GeneratorTransmissions m_generatorTransmissions;
+
   const uint8_t m_cores;
   const uint64_t m_memoryLimit;
 
@@ -0,0 +1,20 @@
+#include "latch.h"
+
+Latch::Latch(uint32_t count) : m_count(count) {}
+
+void Latch::reset(uint32_t count) {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_count = count;
+}
+
+void Latch::countDown() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  if (0 < m_count && --m_count == 0) {
+    m_cv.notify_all();
+  }
+}
+
+void Latch::wait() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_cv.wait(lock, [this]() { return m_count == 0; });
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+// Countdown of forked tasks, wait() returns as soon as the last task calls countDown(). reset() rearms it
+// for the next fork, it must not be called while tasks of the previous fork are still running.
+class Latch {
+ public:
+  Latch(uint32_t count);
+
+  void reset(uint32_t count);
+  void countDown();
+  void wait();
+
+ private:
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  uint32_t m_count;
+};
@@ -5,10 +5,13 @@
 #include <logger.h>
 #include <network/data_controller.h>
 #include <network/mqtt.h>
+#include <radio/generator_sdr_device.h>
 #include <radio/hackrf_sdr_device.h>
+#include <radio/replay_sdr_device.h>
 #include <radio/rtl_sdr_device.h>
 #include <radio/sdr_scanner.h>
 #include <signal.h>
+#include <thread_pool.h>
 #include <version.h>
 
 volatile bool isRunning{true};
@@ -19,27 +22,35 @@ void handler(int) {
 }
 
 template <typename T>
-void createScanners(const Config& config, Mqtt& mqtt, std::vector<std::unique_ptr<SdrScanner>>& scanners) {
-  for (const auto& id : T::listDevices()) {
+void createScanners(const Config& config, Mqtt& mqtt, ThreadPool& pool, const std::vector<std::string>& ids, std::vector<std::unique_ptr<SdrScanner>>& scanners) {
+  for (const auto& id : ids) {
     for (const auto& range : config.userDefinedFrequencyRanges()) {
       if (range.serial == id) {
-        scanners.push_back(std::make_unique<SdrScanner>(config, range.ranges, std::make_unique<T>(config, id), mqtt));
+        scanners.push_back(std::make_unique<SdrScanner>(config, range.ranges, std::make_unique<T>(config, id), mqtt, pool));
         break;
       }
     }
     for (const auto& range : config.userDefinedFrequencyRanges()) {
       if (range.serial == "auto") {
-        scanners.push_back(std::make_unique<SdrScanner>(config, range.ranges, std::make_unique<T>(config, id), mqtt));
+        scanners.push_back(std::make_unique<SdrScanner>(config, range.ranges, std::make_unique<T>(config, id), mqtt, pool));
         break;
       }
     }
   }
 }
 
-std::vector<std::unique_ptr<SdrScanner>> createScanners(const Config& config, Mqtt& mqtt) {
+std::vector<std::unique_ptr<SdrScanner>> createScanners(const Config& config, Mqtt& mqtt, ThreadPool& pool) {
   std::vector<std::unique_ptr<SdrScanner>> scanners;
-  createScanners<HackrfSdrDevice>(config, mqtt, scanners);
-  createScanners<RtlSdrDevice>(config, mqtt, scanners);
+  if (!config.replayPath().empty()) {
+    createScanners<ReplaySdrDevice>(config, mqtt, pool, ReplaySdrDevice::listDevices(config), scanners);
+    return scanners;
+  }
+  if (config.generatorEnabled()) {
+    createScanners<GeneratorSdrDevice>(config, mqtt, pool, GeneratorSdrDevice::listDevices(config), scanners);
+    return scanners;
+  }
+  createScanners<HackrfSdrDevice>(config, mqtt, pool, HackrfSdrDevice::listDevices(), scanners);
+  createScanners<RtlSdrDevice>(config, mqtt, pool, RtlSdrDevice::listDevices(), scanners);
   return scanners;
 }
 
@@ -67,6 +78,8 @@ int main(int argc, char* argv[]) {
   try {
     signal(SIGINT, handler);
     signal(SIGTERM, handler);
+    // shared by the scanners of all devices and kept across config reloads
+    ThreadPool pool("ThreadPool", std::thread::hardware_concurrency());
     bool reloadConfig = false;
     while (isRunning) {
       if (reloadConfig) {
@@ -74,12 +87,12 @@ int main(int argc, char* argv[]) {
       }
       reloadConfig = false;
 
-      // FftwInitializer fftwInitializer(config->cores());
+      FftwInitializer fftwInitializer(*config);
       Mqtt mqtt(*config);
       for (const auto& ignoredFrequencyRange : config->ignoredFrequencyRanges()) {
         Logger::info("main", "ignored frequency, {}", ignoredFrequencyRange.toString());
       }
-      auto scanners = createScanners(*config, mqtt);
+      auto scanners = createScanners(*config, mqtt, pool);
 
       auto f = [&config, &reloadConfig, &scanners, argc, argv](const std::string& topic, const std::string& message) {
         if (topic == "sdr/config") {
@@ -3,6 +3,7 @@
 #include <logger.h>
 #include <utils.h>
 
+#include <algorithm>
 #include <cstdlib>
 #include <memory>
 
@@ -44,9 +45,9 @@ void DataController::pushTransmission(const std::chrono::milliseconds time, cons
   flushTransmission(frequencyRange);
 }
 
-void DataController::pushTransmission(const std::chrono::milliseconds time, const FrequencyRange& frequencyRange, const std::vector<std::complex<float>>& samples, bool isActive) {
-  std::vector<uint8_t> data(samples.size() * 2);
-  for (uint32_t i = 0; i < samples.size(); ++i) {
+void DataController::pushTransmission(const std::chrono::milliseconds time, const FrequencyRange& frequencyRange, const std::complex<float>* samples, uint32_t size, bool isActive) {
+  std::vector<uint8_t> data(size * 2);
+  for (uint32_t i = 0; i < size; ++i) {
     data[2 * i] = samples[i].real() * 127.5f + 127.5f;
     data[2 * i + 1] = samples[i].imag() * 127.5f + 127.5f;
   }
@@ -95,17 +96,17 @@ void DataController::sendTransmission(const FrequencyRange& frequencyRange, cons
   m_mqtt.publish(m_transmissionsTopic, std::move(data));
 }
 
-void DataController::sendSignals(const std::chrono::milliseconds time, const FrequencyRange& frequencyRange, const std::vector<Signal>& signals) {
+void DataController::sendSignals(const std::chrono::milliseconds time, const FrequencyRange& frequencyRange, const Spectrum& spectrum) {
   std::unique_lock lock(m_mutex);
-  std::vector<uint8_t> data(sizeof(uint64_t) + 3 * sizeof(Frequency) + sizeof(uint32_t) + sizeof(int8_t) * signals.size());
+  std::vector<uint8_t> data(sizeof(uint64_t) + 3 * sizeof(Frequency) + sizeof(uint32_t) + sizeof(int8_t) * spectrum.size());
   uint64_t offset = 0;
   add(data.data(), offset, static_cast<uint64_t>(time.count()));
   add(data.data(), offset, frequencyRange.start);
   add(data.data(), offset, frequencyRange.stop);
   add(data.data(), offset, frequencyRange.step());
-  add(data.data(), offset, static_cast<uint32_t>(signals.size()));
-  for (const auto& signal : signals) {
-    add(data.data(), offset, static_cast<int8_t>(signal.power));
+  add(data.data(), offset, spectrum.size());
+  for (uint32_t i = 0; i < spectrum.size(); ++i) {
+    add(data.data(), offset, static_cast<int8_t>(std::clamp(spectrum[i], -128.0f, 127.0f)));
   }
   m_mqtt.publish(m_spectrogramTopic, std::move(data));
 }
@@ -16,9 +16,9 @@ class DataController {
   ~DataController();
 
   void pushTransmission(const std::chrono::milliseconds time, const FrequencyRange& frequencyRange, std::vector<uint8_t>&& samples, bool isActive);
-  void pushTransmission(const std::chrono::milliseconds time, const FrequencyRange& frequencyRange, const std::vector<std::complex<float>>& samples, bool isActive);
+  void pushTransmission(const std::chrono::milliseconds time, const FrequencyRange& frequencyRange, const std::complex<float>* samples, uint32_t size, bool isActive);
   void finishTransmission(const FrequencyRange& frequencyRange);
-  void sendSignals(const std::chrono::milliseconds time, const FrequencyRange& frequencyRange, const std::vector<Signal>& signals);
+  void sendSignals(const std::chrono::milliseconds time, const FrequencyRange& frequencyRange, const Spectrum& spectrum);
 
  private:
   void flushTransmission(const FrequencyRange& frequencyRange);
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <bounded_queue.h>
+#include <logger.h>
+#include <utils.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+constexpr auto PIPELINE_STAGE_LOG_INTERVAL = std::chrono::seconds(10);
+
+// One stage of a pipeline, a thread processing values of a bounded queue in order. tryPush() never blocks the caller,
+// a value that does not fit into the queue is dropped and counted, push() waits for space instead. Values should be dropped
+// only at the pipeline entry, so every value that enters is seen by all stages. Queue occupancy and drops are logged periodically.
+template <typename T>
+class PipelineStage {
+ public:
+  struct Statistics {
+    uint32_t size;
+    uint32_t maxSize;
+    uint64_t processed;
+    uint64_t dropped;
+  };
+
+  PipelineStage(const std::string& name, uint32_t capacity, std::function<void(T&&)> process)
+      : m_name(name),
+        m_process(std::move(process)),
+        m_queue(capacity),
+        m_pending(0),
+        m_maxSize(0),
+        m_processed(0),
+        m_dropped(0),
+        m_lastLog(std::chrono::steady_clock::now()),
+        m_thread([this]() { run(); }) {}
+
+  ~PipelineStage() {
+    m_queue.close();
+    m_thread.join();
+  }
+
+  bool push(T&& value) {
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_pending++;
+    }
+    const auto isPushed = m_queue.push(std::move(value));
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (!isPushed) {
+      m_pending--;
+      m_cv.notify_all();
+      return false;
+    }
+    m_maxSize = std::max(m_maxSize, m_queue.size());
+    return true;
+  }
+
+  bool tryPush(T&& value) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (!m_queue.tryPush(std::move(value))) {
+      m_dropped++;
+      Logger::warn(m_name.c_str(), "queue full, dropped: {}", m_dropped);
+      return false;
+    }
+    m_pending++;
+    m_maxSize = std::max(m_maxSize, m_queue.size());
+    return true;
+  }
+
+  // waits until every pushed value is processed
+  void flush() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_cv.wait(lock, [this]() { return m_pending == 0; });
+  }
+
+  Statistics statistics() const {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    return {m_queue.size(), m_maxSize, m_processed, m_dropped};
+  }
+
+ private:
+  void run() {
+    Logger::info(m_name.c_str(), "start thread id: {}", getThreadId());
+    setThreadParams(m_name, PRIORITY::MEDIUM);
+    while (auto value = m_queue.pop()) {
+      try {
+        m_process(std::move(*value));
+      } catch (const std::exception& exception) {
+        Logger::error(m_name.c_str(), "exception: {}", exception.what());
+      }
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_pending--;
+      m_processed++;
+      m_cv.notify_all();
+      const auto now = std::chrono::steady_clock::now();
+      if (PIPELINE_STAGE_LOG_INTERVAL <= now - m_lastLog) {
+        Logger::info(m_name.c_str(), "queue size: {}/{}, max size: {}, processed: {}, dropped: {}", m_queue.size(), m_queue.capacity(), m_maxSize, m_processed, m_dropped);
+        m_maxSize = m_queue.size();
+        m_lastLog = now;
+      }
+    }
+    Logger::info(m_name.c_str(), "stop thread id: {}", getThreadId());
+  }
+
+  const std::string m_name;
+  const std::function<void(T&&)> m_process;
+  BoundedQueue<T> m_queue;
+  mutable std::mutex m_mutex;
+  std::condition_variable m_cv;
+  uint32_t m_pending;
+  uint32_t m_maxSize;
+  uint64_t m_processed;
+  uint64_t m_dropped;
+  std::chrono::steady_clock::time_point m_lastLog;
+  std::thread m_thread;
+};
@@ -0,0 +1,34 @@
+#include "generator_sdr_device.h"
+
+#include <logger.h>
+#include <utils.h>
+
+constexpr auto GENERATOR_SERIAL = "generator";
+
+GeneratorSdrDevice::GeneratorSdrDevice(const Config &config, const std::string &serial)
+    : StreamingSdrDevice(config, "Generator", config.generatorRealtime()), m_serial(serial), m_generator(config) {
+  Logger::info("Generator", "open device, serial: {}, realtime: {}", m_serial, m_config.generatorRealtime());
+}
+
+GeneratorSdrDevice::~GeneratorSdrDevice() {
+  stopStream();
+  Logger::info("Generator", "close device, serial: {}", m_serial);
+}
+
+std::vector<std::string> GeneratorSdrDevice::listDevices(const Config &config) {
+  if (!config.generatorEnabled()) {
+    return {};
+  }
+  return {GENERATOR_SERIAL};
+}
+
+std::string GeneratorSdrDevice::name() const { return {"generator_" + m_serial}; }
+
+std::string GeneratorSdrDevice::serial() const { return m_serial; }
+
+int32_t GeneratorSdrDevice::offset() const { return 0; }
+
+bool GeneratorSdrDevice::fill(const FrequencyRange &frequencyRange, uint8_t *data, uint32_t size) {
+  m_generator.generate(frequencyRange, samplesTime(), data, size);
+  return true;
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <algorithms/signal_generator.h>
+#include <config.h>
+#include <radio/streaming_sdr_device.h>
+
+// Serves samples synthesized by SignalGenerator for any requested frequency range.
+// Samples are timestamped with the generator clock, so detection behaves the same at any generation speed.
+class GeneratorSdrDevice : public StreamingSdrDevice {
+ public:
+  GeneratorSdrDevice(const Config& config, const std::string& serial);
+  ~GeneratorSdrDevice() override;
+
+  static std::vector<std::string> listDevices(const Config& config);
+
+  std::string name() const override;
+  std::string serial() const override;
+  int32_t offset() const override;
+
+ protected:
+  bool fill(const FrequencyRange& frequencyRange, uint8_t* data, uint32_t size) override;
+
+ private:
+  const std::string m_serial;
+  SignalGenerator m_generator;
+};
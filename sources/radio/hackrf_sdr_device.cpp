@@ -5,6 +5,7 @@
 
 #include <chrono>
 #include <condition_variable>
+#include <cstring>
 #include <mutex>
 #include <thread>
 
@@ -32,7 +33,8 @@ HackRfInitializer::~HackRfInitializer() {
   }
 }
 
-HackrfSdrDevice::HackrfSdrDevice(const Config &config, const std::string &serial) : SdrDevice("HackRF"), m_config(config), m_serial(serial), m_threadInitialized(false) {
+HackrfSdrDevice::HackrfSdrDevice(const Config &config, const std::string &serial)
+    : SdrDevice("HackRF"), m_config(config), m_serial(serial), m_frequency(0), m_sampleRate(0), m_threadInitialized(false), m_timingCounters("HackRfUsb") {
   Logger::info("HackRf", "open device, serial: {}", m_serial);
   if (hackrf_open_by_serial(m_serial.c_str(), &m_device) != HACKRF_SUCCESS) {
     throw std::runtime_error("can not open hackrf device");
@@ -65,11 +67,8 @@ int HackrfSdrDevice::callbackStream(hackrf_transfer *transfer) {
     device->m_threadInitialized = true;
     setThreadParams("hackrf_reader", PRIORITY::MEDIUM);
   }
-  for (int i = 0; i < transfer->valid_length; ++i) {
-    transfer->buffer[i] = (transfer->buffer[i] ^ 0b10000000);
-  }
   if (device->m_readSize == 0) {
-    device->m_timeBuffer.push_back(time());
+    device->pushTime(time());
   }
   device->m_dataBuffer.push(transfer->buffer, transfer->valid_length);
   device->m_readSize += transfer->valid_length;
@@ -104,24 +103,24 @@ void HackrfSdrDevice::startStream(const FrequencyRange &frequencyRange) {
   m_threadInitialized = false;
   const auto samples = getSamplesCount(frequencyRange.sampleRate, m_config.frequencyRangeScanningTime(), HACKRF_MIN_SAMPLES_READ_COUNT);
   Logger::info("HackRf", "start stream, samples: {}", samples);
-  if (hackrf_start_rx(m_device, callbackStream, this) != HACKRF_SUCCESS) {
-    throw std::runtime_error("can not start stream");
-  }
+  checkStatus(m_timingCounters.control("start_rx", [this]() { return hackrf_start_rx(m_device, callbackStream, this); }), "can not start stream");
 }
 
 void HackrfSdrDevice::stopStream() {
   Logger::info("HackRf", "stop stream");
-  if (hackrf_stop_rx(m_device) != HACKRF_SUCCESS) {
-    throw std::runtime_error("can not stop stream");
-  }
+  checkStatus(m_timingCounters.control("stop_rx", [this]() { return hackrf_stop_rx(m_device); }), "can not stop stream");
 }
 
 SdrDevice::Samples HackrfSdrDevice::readData(const FrequencyRange &frequencyRange) {
   startStream(frequencyRange);
-  waitForData();
-  auto &&samples = getStreamData();
+  m_timingCounters.transfer("wait_for_data", [this]() { waitForData(); });
+  const auto samples = getStreamData();
+  auto buffer = m_samplesPool.acquire(samples.size);
+  memcpy(buffer.data(), samples.data, samples.size);
+  releaseStreamData();
   stopStream();
-  return samples;
+  const auto data = buffer.data();
+  return {samples.time, data, samples.size, std::move(buffer)};
 }
 
 std::string HackrfSdrDevice::name() const { return {"hackrf_" + m_serial}; }
@@ -130,6 +129,8 @@ std::string HackrfSdrDevice::serial() const { return m_serial; }
 
 int32_t HackrfSdrDevice::offset() const { return m_config.hackRfOffset(); }
 
+SampleFormat HackrfSdrDevice::format() const { return SampleFormat::CS8; }
+
 void HackrfSdrDevice::setup(const FrequencyRange &frequencyRange) {
   const auto samples = getSamplesCount(frequencyRange.sampleRate, m_config.frequencyRangeScanningTime(), HACKRF_MIN_SAMPLES_READ_COUNT);
   m_samplesSize = samples;
@@ -139,16 +140,21 @@ void HackrfSdrDevice::setup(const FrequencyRange &frequencyRange) {
 
   if (frequencyRange.sampleRate != m_sampleRate) {
     Logger::debug("HackRf", "set sample rate {}", frequencyToString(frequencyRange.sampleRate, "sample rate"));
-    if (hackrf_set_sample_rate(m_device, frequencyRange.sampleRate) != HACKRF_SUCCESS) {
-      throw std::runtime_error("can not set sample rate");
-    }
+    checkStatus(m_timingCounters.control("set_sample_rate", [this, &frequencyRange]() { return hackrf_set_sample_rate(m_device, frequencyRange.sampleRate); }), "can not set sample rate");
     m_sampleRate = frequencyRange.sampleRate;
   }
   if (frequencyRange.center() != m_frequency) {
     Logger::debug("HackRf", "set center {}", frequencyToString(frequencyRange.center()));
-    if (hackrf_set_freq(m_device, frequencyRange.center()) != HACKRF_SUCCESS) {
-      throw std::runtime_error("can not set frequency");
-    }
+    checkStatus(m_timingCounters.control("set_freq", [this, &frequencyRange]() { return hackrf_set_freq(m_device, frequencyRange.center()); }), "can not set frequency");
     m_frequency = frequencyRange.center();
   }
 }
+
+void HackrfSdrDevice::checkStatus(int status, const char *error) {
+  if (status != HACKRF_SUCCESS) {
+    // device state is unknown after failure, so everything is set again on the next setup
+    m_frequency = 0;
+    m_sampleRate = 0;
+    throw std::runtime_error(error);
+  }
+}
@@ -4,6 +4,7 @@
 #include <libhackrf/hackrf.h>
 #include <radio/sdr_device.h>
 #include <ring_buffer.h>
+#include <timing_counters.h>
 
 class HackRfInitializer {
  public:
@@ -27,9 +28,11 @@ class HackrfSdrDevice : public SdrDevice {
   std::string name() const override;
   std::string serial() const override;
   int32_t offset() const override;
+  SampleFormat format() const override;
 
  private:
   void setup(const FrequencyRange& frequencyRange);
+  void checkStatus(int status, const char* error);
 
   const Config& m_config;
   const std::string m_serial;
@@ -38,4 +41,5 @@ class HackrfSdrDevice : public SdrDevice {
   Frequency m_frequency;
   Frequency m_sampleRate;
   bool m_threadInitialized;
+  TimingCounters m_timingCounters;
 };
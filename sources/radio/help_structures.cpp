@@ -61,3 +61,56 @@ bool FrequencyRange::operator==(const FrequencyRange &rhs) const { return start
 bool FrequencyRange::operator<(const FrequencyRange &rhs) const {
   return start < rhs.start || (start == rhs.start && stop < rhs.stop) || (stop == rhs.stop && sampleRate < rhs.sampleRate) || (sampleRate == rhs.sampleRate && fft < rhs.fft);
 }
+
+Spectrum::Spectrum(const FrequencyRange &frequencyRange)
+    : m_frequencyRange(frequencyRange), m_origin(frequencyRange.center() - frequencyRange.sampleRate / 2), m_firstBin(0), m_bins(0) {
+  const uint64_t fft = frequencyRange.fft;
+  const uint64_t sampleRate = frequencyRange.sampleRate;
+  if (frequencyRange.stop < m_origin) {
+    return;
+  }
+  // bin i lies at origin + i * sampleRate / fft (rounded down)
+  const uint64_t startOffset = m_origin < frequencyRange.start ? frequencyRange.start - m_origin : 0;
+  const uint64_t stopOffset = frequencyRange.stop - m_origin;
+  m_firstBin = (startOffset * fft + sampleRate - 1) / sampleRate;
+  const auto lastBin = std::min(((stopOffset + 1) * fft - 1) / sampleRate, fft - 1);
+  if (lastBin < m_firstBin) {
+    return;
+  }
+  m_bins = lastBin - m_firstBin + 1;
+  const auto isPadded = m_origin + lastBin * sampleRate / fft != frequencyRange.stop;
+  m_power.resize(m_bins + (isPadded ? 1 : 0));
+}
+
+const FrequencyRange &Spectrum::frequencyRange() const { return m_frequencyRange; }
+
+Frequency Spectrum::frequency(uint32_t index) const {
+  const auto frequency = m_origin + static_cast<uint64_t>(m_firstBin + index) * m_frequencyRange.sampleRate / m_frequencyRange.fft;
+  return std::min(frequency, static_cast<uint64_t>(m_frequencyRange.stop));
+}
+
+// index of the first value whose frequency is not below the given one, size() if there is none
+uint32_t Spectrum::lowerBound(Frequency frequency) const {
+  if (m_power.empty() || frequency <= this->frequency(0)) {
+    return 0;
+  }
+  if (m_frequencyRange.stop < frequency) {
+    return size();
+  }
+  const auto bin = (static_cast<uint64_t>(frequency - m_origin) * m_frequencyRange.fft + m_frequencyRange.sampleRate - 1) / m_frequencyRange.sampleRate;
+  return std::min(static_cast<uint32_t>(bin - m_firstBin), size() - 1);
+}
+
+uint32_t Spectrum::firstBin() const { return m_firstBin; }
+
+uint32_t Spectrum::bins() const { return m_bins; }
+
+uint32_t Spectrum::size() const { return m_power.size(); }
+
+Power *Spectrum::data() { return m_power.data(); }
+
+const Power *Spectrum::data() const { return m_power.data(); }
+
+Power &Spectrum::operator[](uint32_t index) { return m_power[index]; }
+
+Power Spectrum::operator[](uint32_t index) const { return m_power[index]; }
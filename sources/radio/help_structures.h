@@ -1,11 +1,15 @@
 #pragma once
 
+#include <simd/aligned_allocator.h>
+
 #include <cstdint>
 #include <string>
 
 using Frequency = uint32_t;
 using Power = float;
 
+enum class SampleFormat { CU8, CS8 };
+
 std::string frequencyToString(const Frequency& frequency, const std::string& label = "frequency");
 std::string powerToString(const Power& power);
 
@@ -31,3 +35,30 @@ struct FrequencyRange {
   const Frequency sampleRate;
   const uint32_t fft;
 };
+
+// Powers of the fft bins of a frequency range that lie between its start and stop. Bin frequencies follow from the
+// range and the index, so only powers are stored. When the bins do not end exactly at stop, the last power is
+// repeated there once more.
+class Spectrum {
+ public:
+  Spectrum(const FrequencyRange& frequencyRange);
+
+  const FrequencyRange& frequencyRange() const;
+  Frequency frequency(uint32_t index) const;
+  uint32_t lowerBound(Frequency frequency) const;
+  uint32_t firstBin() const;
+  uint32_t bins() const;
+  uint32_t size() const;
+
+  Power* data();
+  const Power* data() const;
+  Power& operator[](uint32_t index);
+  Power operator[](uint32_t index) const;
+
+ private:
+  const FrequencyRange m_frequencyRange;
+  const Frequency m_origin;
+  uint32_t m_firstBin;
+  uint32_t m_bins;
+  AlignedVector<Power> m_power;
+};
@@ -7,42 +7,89 @@
 
 #include <map>
 
-Recorder::Recorder(const Config& config, int32_t offset, DataController& dataController)
+constexpr auto STAGE_QUEUE_SIZE = 4;
+constexpr auto STREAM_POOL_SIZE = 3 * STAGE_QUEUE_SIZE + 4;
+constexpr auto SAMPLES_POOL_SIZE = 8;
+constexpr auto CHANNELS_POOL_SIZE = 64;
+
+Recorder::Recorder(const Config& config, ThreadPool& pool, int32_t offset, SampleFormat format, DataController& dataController)
     : m_config(config),
       m_offset(offset),
+      m_format(format),
       m_dataController(dataController),
       m_transmissionDetector(config),
-      m_samplesProcessor(config),
+      m_samplesProcessor(config, pool),
       m_performanceLogger("Recorder"),
-      m_lastDataTime(0),
-      m_lastActiveDataTime(0) {}
+      m_streamPool("StreamPool", STREAM_POOL_SIZE),
+      m_samplesPool("SamplesPool", SAMPLES_POOL_SIZE),
+      m_channelsPool("ChannelsPool", CHANNELS_POOL_SIZE),
+      m_channelizer(nullptr),
+      m_channelizerCenter(0),
+      m_lastDataTime(std::chrono::milliseconds(0)),
+      m_lastActiveDataTime(std::chrono::milliseconds(0)),
+      m_workerPool(config, pool, dataController),
+      m_recordingStage("RecordStage", STAGE_QUEUE_SIZE, [this](StreamSamples&& streamSamples) { processRecording(std::move(streamSamples)); }),
+      m_detectionStage("DetectStage", STAGE_QUEUE_SIZE, [this](StreamSamples&& streamSamples) { processDetection(std::move(streamSamples)); }),
+      m_spectrogramStage("SpectrStage", STAGE_QUEUE_SIZE, [this](StreamSamples&& streamSamples) { processSpectrogram(std::move(streamSamples)); }) {}
 
 Recorder::~Recorder() {}
 
 void Recorder::clear() {
-  m_workers.clear();
+  m_spectrogramStage.flush();
+  m_detectionStage.flush();
+  m_recordingStage.flush();
+  releaseWorkers();
+  m_channelizer = nullptr;
   m_lastDataTime = time();
-  m_lastActiveDataTime = m_lastDataTime;
+  m_lastActiveDataTime = m_lastDataTime.load();
 }
 
-bool Recorder::isTransmission(const std::chrono::milliseconds& time, const FrequencyRange& frequencyRange, std::vector<uint8_t>&& samples) {
-  const auto signals = m_samplesProcessor.process(samples, m_rawBuffer, frequencyRange, m_offset);
-  const auto activeTransmissions = m_transmissionDetector.getTransmissions(time, signals);
+bool Recorder::isTransmission(const std::chrono::milliseconds& time, const FrequencyRange& frequencyRange, const uint8_t* samples, const uint32_t samplesSize) {
+  const auto spectrum = m_samplesProcessor.process(samples, samplesSize, frequencyRange, m_offset, m_format);
+  const auto activeTransmissions = m_transmissionDetector.getTransmissions(time, spectrum);
   Logger::trace("Recorder", "active transmissions finished, count: {}", activeTransmissions.size());
-  processSignals(time, frequencyRange, signals);
+  processSignals(time, frequencyRange, spectrum);
   return (!activeTransmissions.empty());
 }
 
-void Recorder::processSamples(const std::chrono::milliseconds& time, const FrequencyRange& frequencyRange, std::vector<uint8_t>&& samples) {
-  Logger::debug("Recorder", "samples processing started");
+// samples are copied out of the device ring buffer, so it is released without waiting for the processing,
+// the copy takes about 0.5% of one core at 20 MS/s (benchmark_stream_copy)
+void Recorder::processSamples(const std::chrono::milliseconds& time, const FrequencyRange& frequencyRange, const uint8_t* samples, const uint32_t samplesSize) {
   m_performanceLogger.newSample();
-  const auto signals = m_samplesProcessor.process(samples, m_rawBuffer, frequencyRange, m_offset);
-  processSignals(time, frequencyRange, signals);
-  const auto rawBufferSamples = samples.size() / 2;
-  const auto activeTransmissions = m_transmissionDetector.getTransmissions(time, signals);
-  Logger::trace("Recorder", "active transmissions finished, count: {}", activeTransmissions.size());
+  auto buffer = m_streamPool.acquire(samplesSize);
+  std::copy(samples, samples + samplesSize, buffer.data());
+  m_spectrogramStage.tryPush({time, frequencyRange, std::move(buffer), nullptr, {}});
+}
+
+void Recorder::processSpectrogram(StreamSamples&& streamSamples) {
+  Logger::debug("Recorder", "spectrogram started");
+  streamSamples.spectrum = std::make_unique<Spectrum>(m_samplesProcessor.process(streamSamples.samples.data(), streamSamples.samples.size(), streamSamples.frequencyRange, m_offset, m_format));
+  m_detectionStage.push(std::move(streamSamples));
+  Logger::debug("Recorder", "spectrogram finished");
+}
+
+void Recorder::processDetection(StreamSamples&& streamSamples) {
+  Logger::debug("Recorder", "detection started");
+  const auto& time = streamSamples.time;
+  processSignals(time, streamSamples.frequencyRange, *streamSamples.spectrum);
+  streamSamples.transmissions = m_transmissionDetector.getTransmissions(time, *streamSamples.spectrum);
+  Logger::trace("Recorder", "active transmissions finished, count: {}", streamSamples.transmissions.size());
+
+  m_lastDataTime = std::max(m_lastDataTime.load(), time);
+  for (const auto& [transmissionSampleRate, isActive] : streamSamples.transmissions) {
+    if (isActive) {
+      m_lastActiveDataTime = std::max(m_lastActiveDataTime.load(), time);
+    }
+  }
+  m_recordingStage.push(std::move(streamSamples));
+  Logger::debug("Recorder", "detection finished");
+}
 
-  m_lastDataTime = std::max(m_lastDataTime, time);
+void Recorder::processRecording(StreamSamples&& streamSamples) {
+  Logger::debug("Recorder", "recording started");
+  const auto& time = streamSamples.time;
+  const auto& frequencyRange = streamSamples.frequencyRange;
+  const auto& activeTransmissions = streamSamples.transmissions;
   for (auto it = m_workers.begin(); it != m_workers.end();) {
     auto f = [it](const std::pair<FrequencyRange, bool>& data) { return it->first == data.first; };
     const auto transmissionInProgress = std::any_of(activeTransmissions.begin(), activeTransmissions.end(), f);
@@ -50,59 +97,107 @@ void Recorder::processSamples(const std::chrono::milliseconds& time, const Frequ
       it++;
     } else {
       const auto frequencyRange = it->first;
+      m_workerPool.release(std::move(it->second->worker));
       it = m_workers.erase(it);
       Logger::info("Recorder", "erase worker {}, total workers: {}", frequencyToString(frequencyRange.center()), m_workers.size());
     }
   }
-  std::shared_ptr<std::vector<std::complex<float>>> sharedSamples;
-  for (const auto& [transmissionSampleRate, isActive] : activeTransmissions) {
-    if (isActive) {
-      m_lastActiveDataTime = std::max(m_lastActiveDataTime, time);
+  if (activeTransmissions.empty()) {
+    m_channelizer = nullptr;
+    Logger::debug("Recorder", "recording finished");
+    return;
+  }
+
+  // the integer part of the ratio is left to the channelizer and worker decimators, the remainder to worker resamplers
+  const auto decimation = std::max(1u, frequencyRange.sampleRate / m_config.minRecordingSampleRate());
+  const auto resampling = resamplingRatio(frequencyRange.sampleRate, decimation, m_config.minRecordingSampleRate());
+
+  // a channelizer of another range would hand workers wrong channels
+  if (!m_channelizer || m_channelizerCenter != frequencyRange.center() || m_channelizer->sampleRate() != frequencyRange.sampleRate) {
+    if (!m_workers.empty()) {
+      Logger::info("Recorder", "frequency range changed, erase workers: {}", m_workers.size());
+      releaseWorkers();
     }
+    m_channelizer = m_workerPool.channelizer(frequencyRange.sampleRate, decimation);
+    m_channelizerCenter = frequencyRange.center();
+  }
+
+  std::vector<std::pair<RecorderWorkerStruct*, bool>> recordings;
+  for (const auto& [transmissionSampleRate, isActive] : activeTransmissions) {
     if (m_workers.count(transmissionSampleRate) == 0) {
-      if (m_config.cores() <= m_workers.size()) {
+      if (m_config.maxConcurrentRecordings() <= m_workers.size()) {
         Logger::warn("Recorder", "reached concurrent transmissions limit, skip {}", frequencyToString(transmissionSampleRate.center()));
         continue;
       }
-      { Logger::info("Recorder", "create worker {}, total workers: {}", frequencyToString(transmissionSampleRate.center()), m_workers.size() + 1); }
+      // device offset is applied here, together with the channel shift
+      const auto frequency = static_cast<int64_t>(transmissionSampleRate.center()) - frequencyRange.center() - m_offset;
+      const auto channel = m_channelizer->channel(frequency);
+      Logger::info(
+          "Recorder",
+          "create worker {}, channel: {}, residual: {}, total workers: {}",
+          frequencyToString(transmissionSampleRate.center()),
+          channel.index,
+          channel.residual,
+          m_workers.size() + 1);
       auto rws = std::make_unique<RecorderWorkerStruct>();
-      auto worker = std::make_unique<RecorderWorker>(m_config, m_dataController, frequencyRange, transmissionSampleRate, rws->mutex, rws->cv, rws->samples);
-      rws->worker = std::move(worker);
+      rws->channel = channel.index;
+      rws->worker = m_workerPool.acquire(transmissionSampleRate, m_channelizer->outputSampleRate(), channel.residual, m_channelizer->workerDecimation(), resampling);
       m_workers.insert({transmissionSampleRate, std::move(rws)});
     }
-    auto& rws = m_workers.at(transmissionSampleRate);
-    std::unique_lock<std::mutex> lock(rws->mutex);
-    if (!sharedSamples) {
-      if (isMemoryLimitReached(m_config.memoryLimit())) {
-        Logger::warn("Recorder", "reached memory limit, skipping samples");
-        break;
-      } else {
-        sharedSamples = std::make_shared<std::vector<std::complex<float>>>(std::move(m_rawBuffer));
-        sharedSamples->resize(rawBufferSamples);
-        m_rawBuffer = {};
-      }
-    }
-    rws->samples.push_back({time, sharedSamples, frequencyRange, isActive});
-    rws->cv.notify_one();
-    Logger::debug("Recorder", "push worker input samples, queue size: {}", rws->samples.size());
+    recordings.emplace_back(m_workers.at(transmissionSampleRate).get(), isActive);
+  }
+  if (recordings.empty()) {
+    Logger::debug("Recorder", "recording finished");
+    return;
+  }
+  if (isMemoryLimitReached(m_config.memoryLimit())) {
+    Logger::warn("Recorder", "reached memory limit, skipping samples");
+    return;
   }
-  Logger::debug("Recorder", "samples processing finished");
+
+  const auto& samples = streamSamples.samples;
+  auto buffer = m_samplesPool.acquire(samples.size() / 2);
+  toComplex(samples.data(), buffer.data(), samples.size(), m_format);
+  const auto outputSize = m_channelizer->outputSize(buffer.size());
+  std::vector<uint32_t> channels;
+  std::vector<SamplesBuffer> outputBuffers;
+  std::vector<std::complex<float>*> outputs;
+  for (const auto& [rws, isActive] : recordings) {
+    channels.push_back(rws->channel);
+    outputBuffers.push_back(m_channelsPool.acquire(outputSize));
+    outputs.push_back(outputBuffers.back().data());
+  }
+  m_channelizer->process(buffer.data(), buffer.size(), channels, outputs);
+  Logger::trace("Recorder", "channelizer finished, channels: {}", channels.size());
+
+  for (uint32_t i = 0; i < recordings.size(); ++i) {
+    const auto& [rws, isActive] = recordings[i];
+    rws->worker->push({time, std::move(outputBuffers[i]), isActive});
+  }
+  Logger::debug("Recorder", "recording finished");
 }
 
-bool Recorder::isTransmissionInProgress() const { return m_lastDataTime <= m_lastActiveDataTime + m_config.maxRecordingNoiseTime(); }
+bool Recorder::isTransmissionInProgress() const { return m_lastDataTime.load() <= m_lastActiveDataTime.load() + m_config.maxRecordingNoiseTime(); }
 
-void Recorder::processSignals(const std::chrono::milliseconds& time, const FrequencyRange& frequencyRange, const std::vector<Signal>& signals) {
+void Recorder::processSignals(const std::chrono::milliseconds& time, const FrequencyRange& frequencyRange, const Spectrum& spectrum) {
   if (m_config.frequencyRangeScanningTime() < std::chrono::seconds(1)) {
     if (m_signalMediators.count(frequencyRange) == 0) {
       m_signalMediators[frequencyRange] = std::make_unique<SignalMediator>(std::chrono::milliseconds(1000));
     }
-    const auto averagedSignals = m_signalMediators[frequencyRange]->append(time, signals);
-    if (!averagedSignals.empty()) {
-      m_dataController.sendSignals(time, frequencyRange, averagedSignals);
+    const auto averagedSpectrum = m_signalMediators[frequencyRange]->append(time, spectrum);
+    if (averagedSpectrum) {
+      m_dataController.sendSignals(time, frequencyRange, *averagedSpectrum);
       Logger::trace("Recorder", "signal sent");
     }
   } else {
-    m_dataController.sendSignals(time, frequencyRange, signals);
+    m_dataController.sendSignals(time, frequencyRange, spectrum);
     Logger::trace("Recorder", "signal sent");
   }
 }
+
+void Recorder::releaseWorkers() {
+  for (auto& [frequencyRange, rws] : m_workers) {
+    m_workerPool.release(std::move(rws->worker));
+  }
+  m_workers.clear();
+}
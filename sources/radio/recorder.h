@@ -1,58 +1,80 @@
 #pragma once
 
-#include <algorithms/decimator.h>
+#include <algorithms/channelizer.h>
 #include <algorithms/signal_mediator.h>
 #include <algorithms/transmission_detector.h>
 #include <network/data_controller.h>
 #include <performance_logger.h>
+#include <pipeline_stage.h>
 #include <radio/recorder_worker.h>
+#include <radio/recorder_worker_pool.h>
 #include <radio/samples_processor.h>
+#include <thread_pool.h>
 #include <utils.h>
 
+#include <atomic>
 #include <complex>
 #include <condition_variable>
 #include <deque>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <queue>
 #include <thread>
 #include <vector>
 
+// Streamed samples go through a pipeline of spectrogram, detection and recorder stages, each stage processes
+// the next chunk while later stages still work on the previous ones.
 class Recorder {
  public:
-  Recorder(const Config& config, int32_t offset, DataController& dataController);
+  Recorder(const Config& config, ThreadPool& pool, int32_t offset, SampleFormat format, DataController& dataController);
   ~Recorder();
 
   void clear();
-  bool isTransmission(const std::chrono::milliseconds& time, const FrequencyRange& frequencyRange, std::vector<uint8_t>&& samples);
+  bool isTransmission(const std::chrono::milliseconds& time, const FrequencyRange& frequencyRange, const uint8_t* samples, const uint32_t samplesSize);
   bool isTransmissionInProgress() const;
-  void processSamples(const std::chrono::milliseconds& time, const FrequencyRange& frequencyRange, std::vector<uint8_t>&& samples);
+  void processSamples(const std::chrono::milliseconds& time, const FrequencyRange& frequencyRange, const uint8_t* samples, const uint32_t samplesSize);
 
  private:
-  void processSignals(const std::chrono::milliseconds& time, const FrequencyRange& frequencyRange, const std::vector<Signal>& signals);
+  struct StreamSamples {
+    std::chrono::milliseconds time;
+    FrequencyRange frequencyRange;
+    BufferPool<uint8_t>::Buffer samples;
+    std::unique_ptr<Spectrum> spectrum;
+    std::vector<std::pair<FrequencyRange, bool>> transmissions;
+  };
+
+  void processSpectrogram(StreamSamples&& streamSamples);
+  void processDetection(StreamSamples&& streamSamples);
+  void processRecording(StreamSamples&& streamSamples);
+  void processSignals(const std::chrono::milliseconds& time, const FrequencyRange& frequencyRange, const Spectrum& spectrum);
+  void releaseWorkers();
   const Config& m_config;
   const int32_t m_offset;
+  const SampleFormat m_format;
   DataController& m_dataController;
   TransmissionDetector m_transmissionDetector;
   SamplesProcessor m_samplesProcessor;
   PerformanceLogger m_performanceLogger;
-  std::vector<std::complex<float>> m_rawBuffer;
-  std::chrono::milliseconds m_lastDataTime;
-  std::chrono::milliseconds m_lastActiveDataTime;
-
-  struct RecorderInputSamples {
-    std::chrono::milliseconds time;
-    std::vector<uint8_t> samples;
-    FrequencyRange frequencyRange;
-  };
+  BufferPool<uint8_t> m_streamPool;
+  BufferPool<std::complex<float>> m_samplesPool;
+  BufferPool<std::complex<float>> m_channelsPool;
+  Channelizer* m_channelizer;
+  Frequency m_channelizerCenter;
+  std::atomic<std::chrono::milliseconds> m_lastDataTime;
+  std::atomic<std::chrono::milliseconds> m_lastActiveDataTime;
 
   struct RecorderWorkerStruct {
-    std::deque<WorkerInputSamples> samples;
-    std::condition_variable cv;
-    std::mutex mutex;
+    uint32_t channel;
     std::unique_ptr<RecorderWorker> worker;
   };
 
+  RecorderWorkerPool m_workerPool;
   std::map<FrequencyRange, std::unique_ptr<RecorderWorkerStruct>> m_workers;
   std::map<FrequencyRange, std::unique_ptr<SignalMediator>> m_signalMediators;
+
+  // declared last and in reverse order, so that every stage stops before the state it uses and the stage it feeds
+  PipelineStage<StreamSamples> m_recordingStage;
+  PipelineStage<StreamSamples> m_detectionStage;
+  PipelineStage<StreamSamples> m_spectrogramStage;
 };
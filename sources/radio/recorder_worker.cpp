@@ -4,79 +4,130 @@
 
 RecorderWorker::RecorderWorker(
     const Config &config,
+    ThreadPool &pool,
     DataController &dataController,
-    const FrequencyRange &inputFrequencyRange,
-    const FrequencyRange &outputFrequency,
-    std::mutex &inMutex,
-    std::condition_variable &inCv,
-    std::deque<WorkerInputSamples> &inSamples)
+    Frequency inputSampleRate,
+    uint32_t decimation,
+    const ResamplingRatio &resampling,
+    std::shared_ptr<const ResamplerFilter> resamplerFilter)
     : m_config(config),
-      m_inputFrequencyRange(inputFrequencyRange),
-      m_outputFrequencyRange(outputFrequency),
+      m_pool(pool),
+      m_inputSampleRate(inputSampleRate),
+      m_decimation(decimation),
+      m_resampling(resampling),
       m_dataController(dataController),
-      m_mutex(inMutex),
-      m_cv(inCv),
-      m_samples(inSamples),
-      m_isWorking(true),
-      m_thread([this]() {
-        Logger::info("RecorderWrk", "start thread id: {}, {}", getThreadId(), frequencyToString(m_outputFrequencyRange.center()));
-        setThreadParams("recorder_worker", PRIORITY::MEDIUM);
-        std::unique_lock<std::mutex> lock(m_mutex);
-        while (m_isWorking) {
-          m_cv.wait(lock);
-          while (m_isWorking && !m_samples.empty()) {
-            WorkerInputSamples inputSamples = std::move(m_samples.front());
-            m_samples.pop_front();
-            Logger::debug("RecorderWrk", "thread id: {}, processing {} started, queue size: {}", getThreadId(), frequencyToString(m_outputFrequencyRange.center()), m_samples.size());
-            lock.unlock();
-            processSamples(std::move(inputSamples));
-            lock.lock();
-            Logger::debug("RecorderWrk", "thread id: {}, processing {} finished", getThreadId(), frequencyToString(m_outputFrequencyRange.center()));
-          }
-        }
-        m_dataController.finishTransmission(m_outputFrequencyRange);
-        Logger::info("RecorderWrk", "stop thread id: {}, {}, queue size: {}", getThreadId(), frequencyToString(m_outputFrequencyRange.center()), m_samples.size());
-      }) {}
+      m_decimator(1 < decimation ? std::make_unique<Decimator>(decimation) : nullptr),
+      m_resampler(resampling.interpolation != resampling.decimation ? std::make_unique<Resampler>(resampling, std::move(resamplerFilter)) : nullptr),
+      m_isScheduled(false),
+      m_isWorking(false) {}
 
-RecorderWorker::~RecorderWorker() {
-  m_isWorking = false;
+RecorderWorker::~RecorderWorker() { finish(); }
+
+bool RecorderWorker::isCompatible(Frequency inputSampleRate, uint32_t decimation, const ResamplingRatio &resampling) const {
+  return m_inputSampleRate == inputSampleRate && m_decimation == decimation && m_resampling.interpolation == resampling.interpolation &&
+         m_resampling.decimation == resampling.decimation;
+}
+
+// only the oscillator depends on the transmission, filters are cleared instead of designed again
+void RecorderWorker::start(const FrequencyRange &outputFrequency, int32_t frequencyOffset) {
+  m_outputFrequencyRange.emplace(outputFrequency);
+  m_nco = frequencyOffset != 0 ? std::make_unique<Nco>(-frequencyOffset, m_inputSampleRate) : nullptr;
+  if (m_decimator) {
+    m_decimator->reset();
+  }
+  if (m_resampler) {
+    m_resampler->reset();
+  }
+  m_samplesData.clear();
   {
     std::unique_lock<std::mutex> lock(m_mutex);
-    m_cv.notify_one();
+    m_isWorking = true;
   }
-  m_thread.join();
+  Logger::info("RecorderWrk", "start {}", frequencyToString(m_outputFrequencyRange->center()));
 }
 
-void RecorderWorker::processSamples(WorkerInputSamples &&inputSamples) {
-  Logger::debug("RecorderWrk", "thread id: {}, processing started, samples: {}", getThreadId(), inputSamples.samples->size());
-  const auto sampleRate = inputSamples.frequencyRange.sampleRate;
-  const auto decimateRate(sampleRate / (m_outputFrequencyRange.stop - m_outputFrequencyRange.start));
-  const auto rawBufferSamples = inputSamples.samples->size();
-  const auto downSamples = rawBufferSamples / decimateRate;
-  const auto center = inputSamples.frequencyRange.center();
+void RecorderWorker::finish() {
+  if (!m_outputFrequencyRange) {
+    return;
+  }
+  uint32_t queueSize = 0;
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_isWorking = false;
+    m_cv.wait(lock, [this]() { return !m_isScheduled; });
+    queueSize = m_samples.size();
+    m_samples.clear();
+  }
+  m_dataController.finishTransmission(*m_outputFrequencyRange);
+  Logger::info("RecorderWrk", "stop {}, queue size: {}", frequencyToString(m_outputFrequencyRange->center()), queueSize);
+  m_outputFrequencyRange.reset();
+}
 
-  if (m_samplesData.size() < rawBufferSamples) {
-    m_samplesData.resize(rawBufferSamples);
+void RecorderWorker::push(WorkerInputSamples &&inputSamples) {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_samples.push_back(std::move(inputSamples));
+  Logger::debug("RecorderWrk", "push input samples {}, queue size: {}", frequencyToString(m_outputFrequencyRange->center()), m_samples.size());
+  if (!m_isScheduled) {
+    m_isScheduled = true;
+    m_pool.submit([this]() { processQueue(); });
   }
-  if (m_shiftData.size() < rawBufferSamples) {
-    m_shiftData = getShiftData(center - m_outputFrequencyRange.center(), sampleRate, rawBufferSamples);
-    Logger::debug("RecorderWrk", "thread id: {}, shift data resized, size: {}", getThreadId(), m_shiftData.size());
+}
+
+// one chunk per task, the next chunk is resubmitted so that workers of other transmissions are not starved
+void RecorderWorker::processQueue() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  if (m_isWorking && !m_samples.empty()) {
+    WorkerInputSamples inputSamples = std::move(m_samples.front());
+    m_samples.pop_front();
+    Logger::debug("RecorderWrk", "thread id: {}, processing {} started, queue size: {}", getThreadId(), frequencyToString(m_outputFrequencyRange->center()), m_samples.size());
+    lock.unlock();
+    processSamples(std::move(inputSamples));
+    lock.lock();
+    Logger::debug("RecorderWrk", "thread id: {}, processing {} finished", getThreadId(), frequencyToString(m_outputFrequencyRange->center()));
+  }
+  if (m_isWorking && !m_samples.empty()) {
+    m_pool.submit([this]() { processQueue(); });
+  } else {
+    m_isScheduled = false;
+    m_cv.notify_one();
   }
-  if (m_decimatorBuffer.size() < downSamples) {
-    m_decimatorBuffer.resize(downSamples);
-    Logger::debug("RecorderWrk", "thread id: {}, decimator buffer resized, size: {}", getThreadId(), m_decimatorBuffer.size());
+}
+
+// samples left over by the decimation are kept for the next chunk, the resampler keeps its own history
+void RecorderWorker::processSamples(WorkerInputSamples &&inputSamples) {
+  Logger::debug("RecorderWrk", "thread id: {}, processing started, samples: {}", getThreadId(), inputSamples.samples.size());
+  if (m_nco) {
+    m_nco->mix(inputSamples.samples.data(), inputSamples.samples.size());
+    Logger::trace("RecorderWrk", "thread id: {}, shift finished", getThreadId());
   }
-  if (!m_decimator) {
-    m_decimator = std::make_unique<Decimator>(m_config, decimateRate);
+  const std::complex<float> *samples = inputSamples.samples.data();
+  uint32_t size = inputSamples.samples.size();
+
+  if (m_decimator) {
+    m_samplesData.insert(m_samplesData.end(), samples, samples + size);
+    const auto downSamples = m_samplesData.size() / m_decimation;
+    if (m_decimatorBuffer.size() < downSamples) {
+      m_decimatorBuffer.resize(downSamples);
+      Logger::debug("RecorderWrk", "thread id: {}, decimator buffer resized, size: {}", getThreadId(), m_decimatorBuffer.size());
+    }
+    m_decimator->decimate(m_samplesData.data(), downSamples, m_decimatorBuffer.data());
+    m_samplesData.erase(m_samplesData.begin(), m_samplesData.begin() + downSamples * m_decimation);
+    samples = m_decimatorBuffer.data();
+    size = downSamples;
+    Logger::trace("RecorderWrk", "thread id: {}, decimate finished", getThreadId());
   }
 
-  std::copy(inputSamples.samples->begin(), inputSamples.samples->end(), m_samplesData.begin());
-  shift(m_samplesData.data(), m_shiftData, rawBufferSamples);
-  Logger::trace("RecorderWrk", "thread id: {}, shift finished", getThreadId());
-  m_decimator->decimate(m_samplesData.data(), downSamples, m_decimatorBuffer.data());
-  Logger::trace("RecorderWrk", "thread id: {}, decimate finished", getThreadId());
+  if (m_resampler) {
+    if (m_resamplerBuffer.size() < m_resampler->maxOutputSize(size)) {
+      m_resamplerBuffer.resize(m_resampler->maxOutputSize(size));
+      Logger::debug("RecorderWrk", "thread id: {}, resampler buffer resized, size: {}", getThreadId(), m_resamplerBuffer.size());
+    }
+    size = m_resampler->resample(samples, size, m_resamplerBuffer.data());
+    samples = m_resamplerBuffer.data();
+    Logger::trace("RecorderWrk", "thread id: {}, resample finished", getThreadId());
+  }
 
-  m_dataController.pushTransmission(inputSamples.time, m_outputFrequencyRange, m_decimatorBuffer, inputSamples.isActive);
+  m_dataController.pushTransmission(inputSamples.time, *m_outputFrequencyRange, samples, size, inputSamples.isActive);
   Logger::trace("RecorderWrk", "thread id: {}, push transmission finished", getThreadId());
 
   Logger::debug("RecorderWrk", "thread id: {}, processing finished", getThreadId());
@@ -1,55 +1,71 @@
 #pragma once
 
 #include <algorithms/decimator.h>
-#include <algorithms/spectrogram.h>
-#include <algorithms/transmission_detector.h>
+#include <algorithms/nco.h>
+#include <algorithms/resampler.h>
+#include <buffer_pool.h>
 #include <network/data_controller.h>
+#include <thread_pool.h>
 #include <utils.h>
 
 #include <condition_variable>
 #include <cstdint>
 #include <deque>
 #include <mutex>
+#include <optional>
 #include <queue>
-#include <thread>
 #include <vector>
 
+using SamplesBuffer = BufferPool<std::complex<float>>::Buffer;
+
+// Samples of the worker channel, already filtered and decimated by the recorder channelizer
 struct WorkerInputSamples {
   std::chrono::milliseconds time;
-  std::shared_ptr<std::vector<std::complex<float>>> samples;
-  FrequencyRange frequencyRange;
+  SamplesBuffer samples;
   bool isActive;
 };
 
+// Records one transmission at a time, chunks are processed in order as thread pool tasks, one task at a time. After finish()
+// the worker can be started for another transmission of the same rates, its filters are designed only once.
 class RecorderWorker {
  public:
   RecorderWorker(
       const Config &config,
+      ThreadPool &pool,
       DataController &dataController,
-      const FrequencyRange &inputFrequencyRange,
-      const FrequencyRange &outputFrequency,
-      std::mutex &inMutex,
-      std::condition_variable &inCv,
-      std::deque<WorkerInputSamples> &inSamples);
+      Frequency inputSampleRate,
+      uint32_t decimation,
+      const ResamplingRatio &resampling,
+      std::shared_ptr<const ResamplerFilter> resamplerFilter);
   ~RecorderWorker();
 
+  bool isCompatible(Frequency inputSampleRate, uint32_t decimation, const ResamplingRatio &resampling) const;
+  void start(const FrequencyRange &outputFrequency, int32_t frequencyOffset);
+  void finish();
+  void push(WorkerInputSamples &&inputSamples);
+
  private:
+  void processQueue();
   void processSamples(WorkerInputSamples &&inputSamples);
 
   const Config &m_config;
-  const FrequencyRange m_inputFrequencyRange;
-  const FrequencyRange m_outputFrequencyRange;
+  ThreadPool &m_pool;
+  const Frequency m_inputSampleRate;
+  const uint32_t m_decimation;
+  const ResamplingRatio m_resampling;
   DataController &m_dataController;
+  std::optional<FrequencyRange> m_outputFrequencyRange;
 
   std::vector<std::complex<float>> m_samplesData;
-  std::vector<std::complex<float>> m_shiftData;
   std::vector<std::complex<float>> m_decimatorBuffer;
+  std::vector<std::complex<float>> m_resamplerBuffer;
+  std::unique_ptr<Nco> m_nco;
   std::unique_ptr<Decimator> m_decimator;
+  std::unique_ptr<Resampler> m_resampler;
 
-  std::mutex &m_mutex;
-  std::condition_variable &m_cv;
-  std::deque<WorkerInputSamples> &m_samples;
-
-  std::atomic_bool m_isWorking;
-  std::thread m_thread;
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  std::deque<WorkerInputSamples> m_samples;
+  bool m_isScheduled;
+  bool m_isWorking;
 };
@@ -0,0 +1,63 @@
+#include "recorder_worker_pool.h"
+
+#include <logger.h>
+
+#include <algorithm>
+
+RecorderWorkerPool::RecorderWorkerPool(const Config& config, ThreadPool& pool, DataController& dataController)
+    : m_config(config), m_pool(pool), m_dataController(dataController), m_createdWorkers(0), m_reusedWorkers(0) {}
+
+std::unique_ptr<RecorderWorker> RecorderWorkerPool::acquire(
+    const FrequencyRange& outputFrequency, Frequency inputSampleRate, int32_t frequencyOffset, uint32_t decimation, const ResamplingRatio& resampling) {
+  std::unique_ptr<RecorderWorker> worker;
+  const auto it = std::find_if(m_workers.begin(), m_workers.end(), [&](const std::unique_ptr<RecorderWorker>& worker) { return worker->isCompatible(inputSampleRate, decimation, resampling); });
+  if (it != m_workers.end()) {
+    worker = std::move(*it);
+    m_workers.erase(it);
+    m_reusedWorkers++;
+  } else {
+    worker = std::make_unique<RecorderWorker>(m_config, m_pool, m_dataController, inputSampleRate, decimation, resampling, resamplerFilter(resampling));
+    m_createdWorkers++;
+  }
+  Logger::info("WorkerPool", "acquire worker, created: {}, reused: {}, idle: {}", m_createdWorkers, m_reusedWorkers, m_workers.size());
+  worker->start(outputFrequency, frequencyOffset);
+  return worker;
+}
+
+// the oldest idle worker is dropped when more workers are finished than can record at once
+void RecorderWorkerPool::release(std::unique_ptr<RecorderWorker>&& worker) {
+  worker->finish();
+  m_workers.push_back(std::move(worker));
+  if (m_config.maxConcurrentRecordings() < m_workers.size()) {
+    m_workers.erase(m_workers.begin());
+  }
+}
+
+// the channelizer does not depend on the center frequency, only its state is cleared for another range
+Channelizer* RecorderWorkerPool::channelizer(Frequency sampleRate, uint32_t decimation) {
+  auto& channelizer = m_channelizers[{sampleRate, decimation}];
+  if (channelizer) {
+    channelizer->reset();
+  } else {
+    channelizer = createChannelizer(m_config, sampleRate, decimation);
+    Logger::info("WorkerPool", "create channelizer, {}, decimation: {}, channelizers: {}", frequencyToString(sampleRate, "sample rate"), decimation, m_channelizers.size());
+  }
+  return channelizer.get();
+}
+
+std::shared_ptr<const ResamplerFilter> RecorderWorkerPool::resamplerFilter(const ResamplingRatio& resampling) {
+  if (resampling.interpolation == resampling.decimation) {
+    return nullptr;
+  }
+  auto& filter = m_resamplerFilters[{resampling.interpolation, resampling.decimation}];
+  if (!filter) {
+    filter = ::resamplerFilter(resampling);
+  }
+  return filter;
+}
+
+uint64_t RecorderWorkerPool::createdWorkers() const { return m_createdWorkers; }
+
+uint64_t RecorderWorkerPool::reusedWorkers() const { return m_reusedWorkers; }
+
+uint32_t RecorderWorkerPool::idleWorkers() const { return m_workers.size(); }
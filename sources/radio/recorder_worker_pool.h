@@ -0,0 +1,42 @@
+#pragma once
+
+#include <algorithms/channelizer.h>
+#include <config.h>
+#include <network/data_controller.h>
+#include <radio/recorder_worker.h>
+#include <thread_pool.h>
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+
+// Finished recorder workers kept for the next transmissions. A worker is reused when its input rate, decimation and
+// resampling match, so busy bands do not design the same filters again for every transmission. Resampler filters are
+// designed once per ratio and shared by all workers, channelizers are created once per sample rate and decimation.
+class RecorderWorkerPool {
+ public:
+  RecorderWorkerPool(const Config& config, ThreadPool& pool, DataController& dataController);
+
+  std::unique_ptr<RecorderWorker> acquire(
+      const FrequencyRange& outputFrequency, Frequency inputSampleRate, int32_t frequencyOffset, uint32_t decimation, const ResamplingRatio& resampling);
+  void release(std::unique_ptr<RecorderWorker>&& worker);
+  // owned by the pool, returned cleared and valid until the pool is destroyed
+  Channelizer* channelizer(Frequency sampleRate, uint32_t decimation);
+
+  uint64_t createdWorkers() const;
+  uint64_t reusedWorkers() const;
+  uint32_t idleWorkers() const;
+
+ private:
+  std::shared_ptr<const ResamplerFilter> resamplerFilter(const ResamplingRatio& resampling);
+
+  const Config& m_config;
+  ThreadPool& m_pool;
+  DataController& m_dataController;
+  std::vector<std::unique_ptr<RecorderWorker>> m_workers;
+  std::map<std::pair<uint32_t, uint32_t>, std::shared_ptr<const ResamplerFilter>> m_resamplerFilters;
+  std::map<std::pair<Frequency, uint32_t>, std::unique_ptr<Channelizer>> m_channelizers;
+  uint64_t m_createdWorkers;
+  uint64_t m_reusedWorkers;
+};
@@ -0,0 +1,87 @@
+#include "replay_sdr_device.h"
+
+#include <logger.h>
+#include <utils.h>
+
+#include <regex>
+#include <stdexcept>
+
+constexpr auto REPLAY_SERIAL = "replay";
+
+static bool isSignedFile(const std::string &path) { return path.size() >= 4 && path.substr(path.size() - 4) == ".cs8"; }
+
+static Frequency parseFilename(const std::string &path, const uint32_t index) {
+  std::smatch match;
+  const std::regex regex(R"(_(\d+)_(\d+)_fc\.c[su]8$)");
+  if (!std::regex_search(path, match, regex)) {
+    throw std::runtime_error("can not read frequency and sample rate from replay file name");
+  }
+  return std::stoul(match[index].str());
+}
+
+ReplaySdrDevice::ReplaySdrDevice(const Config &config, const std::string &serial)
+    : StreamingSdrDevice(config, "Replay", config.replayRealtime()),
+      m_serial(serial),
+      m_isSigned(isSignedFile(config.replayPath())),
+      m_frequency(config.replayFrequency() ? config.replayFrequency() : parseFilename(config.replayPath(), 1)),
+      m_sampleRate(config.replaySampleRate() ? config.replaySampleRate() : parseFilename(config.replayPath(), 2)),
+      m_lastFrequency(m_frequency) {
+  Logger::info("Replay", "open file: {}, {}, {}, realtime: {}", m_config.replayPath(), frequencyToString(m_frequency), frequencyToString(m_sampleRate, "sample rate"), m_config.replayRealtime());
+  m_file.open(m_config.replayPath(), std::ios::binary | std::ios::in | std::ios::ate);
+  if (!m_file.is_open()) {
+    throw std::runtime_error("can not open replay file");
+  }
+  if (m_file.tellg() < 2) {
+    throw std::runtime_error("empty replay file");
+  }
+  m_file.seekg(0);
+}
+
+ReplaySdrDevice::~ReplaySdrDevice() {
+  stopStream();
+  Logger::info("Replay", "close file: {}", m_config.replayPath());
+}
+
+std::vector<std::string> ReplaySdrDevice::listDevices(const Config &config) {
+  if (config.replayPath().empty()) {
+    return {};
+  }
+  return {REPLAY_SERIAL};
+}
+
+std::string ReplaySdrDevice::name() const { return {"replay_" + m_serial}; }
+
+std::string ReplaySdrDevice::serial() const { return m_serial; }
+
+int32_t ReplaySdrDevice::offset() const { return 0; }
+
+SampleFormat ReplaySdrDevice::format() const { return m_isSigned ? SampleFormat::CS8 : SampleFormat::CU8; }
+
+void ReplaySdrDevice::setup(const FrequencyRange &frequencyRange) {
+  if (frequencyRange.sampleRate != m_sampleRate) {
+    throw std::runtime_error("replay sample rate mismatch");
+  }
+  if (frequencyRange.center() != m_lastFrequency) {
+    Logger::warn("Replay", "requested {} differs from recorded {}", frequencyToString(frequencyRange.center()), frequencyToString(m_frequency));
+    m_lastFrequency = frequencyRange.center();
+  }
+  StreamingSdrDevice::setup(frequencyRange);
+}
+
+bool ReplaySdrDevice::fill(const FrequencyRange &, uint8_t *data, uint32_t size) {
+  uint32_t readSize = 0;
+  while (readSize < size) {
+    m_file.read(reinterpret_cast<char *>(data + readSize), size - readSize);
+    readSize += m_file.gcount();
+    if (readSize < size) {
+      if (!m_config.replayLoop()) {
+        Logger::info("Replay", "end of file, samples time: {} ms", std::chrono::duration_cast<std::chrono::milliseconds>(samplesTime()).count());
+        return false;
+      }
+      Logger::debug("Replay", "rewind file");
+      m_file.clear();
+      m_file.seekg(0);
+    }
+  }
+  return true;
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <config.h>
+#include <radio/streaming_sdr_device.h>
+
+#include <fstream>
+
+// Serves samples recorded by RawFile (hackrfscanner_*_<frequency>_<sample rate>_fc.cu8/.cs8) instead of a real device.
+// Samples are timestamped with the recording clock, so detection behaves the same at any replay speed.
+class ReplaySdrDevice : public StreamingSdrDevice {
+ public:
+  ReplaySdrDevice(const Config& config, const std::string& serial);
+  ~ReplaySdrDevice() override;
+
+  static std::vector<std::string> listDevices(const Config& config);
+
+  std::string name() const override;
+  std::string serial() const override;
+  int32_t offset() const override;
+  SampleFormat format() const override;
+
+ protected:
+  void setup(const FrequencyRange& frequencyRange) override;
+  bool fill(const FrequencyRange& frequencyRange, uint8_t* data, uint32_t size) override;
+
+ private:
+  const std::string m_serial;
+  const bool m_isSigned;
+  const Frequency m_frequency;
+  const Frequency m_sampleRate;
+  Frequency m_lastFrequency;
+  std::ifstream m_file;
+};
@@ -4,13 +4,27 @@
 #include <rtl-sdr.h>
 #include <utils.h>
 
+#include <algorithm>
 #include <chrono>
 
 constexpr uint32_t RTLSDR_MIN_SAMPLES_READ_COUNT = 262144;
+constexpr uint32_t RTLSDR_MAX_SETTLE_SIZE = 262144;
 
 int getDeviceIndex(const std::string& serial) { return rtlsdr_get_index_by_serial(serial.c_str()); }
 
-RtlSdrDevice::RtlSdrDevice(const Config& config, const std::string& serial) : SdrDevice("RtlSdr"), m_config(config), m_serial(serial), m_deviceIndex(getDeviceIndex(serial)) { open(); }
+RtlSdrDevice::RtlSdrDevice(const Config& config, const std::string& serial)
+    : SdrDevice("RtlSdr"),
+      m_config(config),
+      m_serial(serial),
+      m_deviceIndex(getDeviceIndex(serial)),
+      m_isDeviceAvailable(false),
+      m_lastBandwidth(0),
+      m_lastSampleRate(0),
+      m_lastFrequency(0),
+      m_settleEstimator("RtlSdr", RTLSDR_MAX_SETTLE_SIZE),
+      m_timingCounters("RtlSdrUsb") {
+  open();
+}
 
 RtlSdrDevice::~RtlSdrDevice() { close(); }
 
@@ -21,7 +35,7 @@ void RtlSdrDevice::startStream(const FrequencyRange& frequencyRange) {
       Logger::debug("RtlSdr", "read bytes: {}", size);
       RtlSdrDevice* device = reinterpret_cast<RtlSdrDevice*>(ctx);
       device->m_dataBuffer.push(buf, size);
-      device->m_timeBuffer.push_back(time());
+      device->pushTime(time());
       device->m_cv.notify_one();
       device->m_performanceLogger.newSample();
     };
@@ -42,18 +56,20 @@ SdrDevice::Samples RtlSdrDevice::readData(const FrequencyRange& frequencyRange)
   const auto sampleRate = frequencyRange.sampleRate;
   const auto samples = getSamplesCount(sampleRate, m_config.frequencyRangeScanningTime(), RTLSDR_MIN_SAMPLES_READ_COUNT);
 
-  setupDevice(frequencyRange);
+  // after retune read ahead and discard only samples measured as unsettled
+  const auto settleSize = setupDevice(frequencyRange) ? m_settleEstimator.size() : 0;
   int read{0};
-  std::vector<uint8_t> buffer(samples);
-  const auto status = rtlsdr_read_sync(m_device, buffer.data(), samples, &read);
-  if (status != 0) {
-    throw std::runtime_error("read samples error");
-  } else if (read != static_cast<int>(samples)) {
+  auto buffer = m_samplesPool.acquire(settleSize + samples);
+  const auto status = m_timingCounters.transfer("read_sync", [this, &buffer, &read]() { return rtlsdr_read_sync(m_device, buffer.data(), buffer.size(), &read); });
+  checkStatus(status, "read samples error");
+  if (read != static_cast<int>(buffer.size())) {
     throw std::runtime_error("read samples error, dropped samples");
   } else {
-    Logger::debug("RtlSdr", "read bytes: {}", samples);
+    Logger::debug("RtlSdr", "read bytes: {}, settle bytes: {}", buffer.size(), settleSize);
     m_performanceLogger.newSample();
-    return {time(), buffer};
+    const auto unsettledSize = settleSize ? std::min(m_settleEstimator.update(buffer.data(), buffer.size()), settleSize) : 0;
+    const auto data = buffer.data() + unsettledSize;
+    return {time(), data, samples, std::move(buffer)};
   }
 }
 
@@ -116,13 +132,24 @@ void RtlSdrDevice::waitForDeviceAvailable() {
   // hack because rtl-sdr device sometimes failed
   for (int i = 0; i < 10; ++i) {
     Logger::debug("RtlSdr", "check device availability: {}", i);
-    if (rtlsdr_set_tuner_bandwidth(m_device, m_lastBandwidth) == 0) {
+    if (m_timingCounters.control("check_availability", [this]() { return rtlsdr_set_tuner_bandwidth(m_device, m_lastBandwidth); }) == 0) {
       break;
     }
   }
 }
 
-void RtlSdrDevice::setupDevice(const FrequencyRange& frequencyRange) {
+void RtlSdrDevice::checkStatus(int status, const char* error) {
+  if (status != 0) {
+    // device state is unknown after failure, so everything is set again and availability is checked on the next setup
+    m_isDeviceAvailable = false;
+    m_lastBandwidth = 0;
+    m_lastSampleRate = 0;
+    m_lastFrequency = 0;
+    throw std::runtime_error(error);
+  }
+}
+
+bool RtlSdrDevice::setupDevice(const FrequencyRange& frequencyRange) {
   const auto centerFrequency = frequencyRange.center();
   const auto bandwidth = frequencyRange.sampleRate;
   const auto sampleRate = frequencyRange.sampleRate;
@@ -132,30 +159,30 @@ void RtlSdrDevice::setupDevice(const FrequencyRange& frequencyRange) {
   m_dataBuffer.clear();
   m_timeBuffer.clear();
 
-  waitForDeviceAvailable();
+  if (!m_isDeviceAvailable) {
+    waitForDeviceAvailable();
+    m_isDeviceAvailable = true;
+  }
   if (m_lastBandwidth != bandwidth) {
     Logger::debug("RtlSdr", "set {}", frequencyToString(bandwidth, "bandwidth"));
-    if (rtlsdr_set_tuner_bandwidth(m_device, bandwidth) != 0) {
-      throw std::runtime_error("set bandwidth error");
-    }
+    checkStatus(m_timingCounters.control("set_bandwidth", [this, bandwidth]() { return rtlsdr_set_tuner_bandwidth(m_device, bandwidth); }), "set bandwidth error");
     m_lastBandwidth = bandwidth;
     resetBuffer = true;
   }
-  if (rtlsdr_get_sample_rate(m_device) != sampleRate) {
+  if (m_lastSampleRate != sampleRate) {
     Logger::debug("RtlSdr", "set {}", frequencyToString(sampleRate, "sample rate"));
-    if (rtlsdr_set_sample_rate(m_device, sampleRate) != 0) {
-      throw std::runtime_error("set sample rate error");
-    }
+    checkStatus(m_timingCounters.control("set_sample_rate", [this, sampleRate]() { return rtlsdr_set_sample_rate(m_device, sampleRate); }), "set sample rate error");
+    m_lastSampleRate = sampleRate;
     resetBuffer = true;
   }
-  if (rtlsdr_get_center_freq(m_device) != centerFrequency) {
+  if (m_lastFrequency != centerFrequency) {
     Logger::debug("RtlSdr", "set {}", frequencyToString(centerFrequency, "center frequency"));
-    if (rtlsdr_set_center_freq(m_device, centerFrequency) != 0) {
-      throw std::runtime_error("set center frequency error");
-    }
+    checkStatus(m_timingCounters.control("set_center_freq", [this, centerFrequency]() { return rtlsdr_set_center_freq(m_device, centerFrequency); }), "set center frequency error");
+    m_lastFrequency = centerFrequency;
     resetBuffer = true;
   }
-  if (resetBuffer && rtlsdr_reset_buffer(m_device) != 0) {
-    throw std::runtime_error("reset buffer error");
+  if (resetBuffer) {
+    checkStatus(m_timingCounters.control("reset_buffer", [this]() { return rtlsdr_reset_buffer(m_device); }), "reset buffer error");
   }
+  return resetBuffer;
 }
@@ -3,6 +3,8 @@
 #include <config.h>
 #include <radio/help_structures.h>
 #include <radio/sdr_device.h>
+#include <radio/settle_estimator.h>
+#include <timing_counters.h>
 
 #include <thread>
 
@@ -27,12 +29,18 @@ class RtlSdrDevice : public SdrDevice {
   void open();
   void close();
   void waitForDeviceAvailable();
-  void setupDevice(const FrequencyRange& frequencyRange);
+  void checkStatus(int status, const char* error);
+  bool setupDevice(const FrequencyRange& frequencyRange);
 
   const Config& m_config;
   const std::string m_serial;
   const int m_deviceIndex;
   rtlsdr_dev_t* m_device;
+  bool m_isDeviceAvailable;
   Frequency m_lastBandwidth;
+  Frequency m_lastSampleRate;
+  Frequency m_lastFrequency;
+  SettleEstimator m_settleEstimator;
+  TimingCounters m_timingCounters;
   std::unique_ptr<std::thread> m_thread;
 };
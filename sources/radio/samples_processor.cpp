@@ -3,46 +3,35 @@
 #include <logger.h>
 #include <utils.h>
 
-SamplesProcessor::SamplesProcessor(const Config &config) {
+SamplesProcessor::SamplesProcessor(const Config &config, ThreadPool &pool) : m_latch(0) {
   for (int i = 0; i < config.cores(); ++i) {
-    m_workers.push_back(std::make_unique<SamplesProcessorWorker>(config, m_mutex, m_cv, m_signals));
+    m_workers.push_back(std::make_unique<SamplesProcessorWorker>(config, pool, m_mutex, m_latch, m_spectrum));
   }
 }
 
 SamplesProcessor::~SamplesProcessor() {}
 
-std::vector<Signal> SamplesProcessor::process(const std::vector<uint8_t> &input, std::vector<std::complex<float>> &output, const FrequencyRange &frequencyRange, const int32_t frequencyOffset) {
+Spectrum SamplesProcessor::process(const uint8_t *input, const uint32_t inputSize, const FrequencyRange &frequencyRange, const int32_t frequencyOffset, const SampleFormat format) {
   Logger::trace("SamplesProc", "start processing");
-  if (output.size() < input.size() / 2) {
-    output.resize(input.size() / 2);
-  }
-
   uint32_t dataOffset = 0;
-  uint32_t dataSize = input.size() / m_workers.size();
+  uint32_t dataSize = inputSize / m_workers.size();
+  m_latch.reset(m_workers.size());
   for (auto &worker : m_workers) {
-    worker->push({input.data(), output.data(), frequencyRange, frequencyOffset, dataOffset, dataSize});
+    worker->push({input, frequencyRange, frequencyOffset, format, dataOffset, dataSize});
     dataOffset += dataSize;
   }
   Logger::trace("SamplesProc", "start waiting");
-  while (true) {
-    std::unique_lock<std::mutex> lock(m_mutex);
-    m_cv.wait_for(lock, std::chrono::milliseconds(10));
-    if (m_workers.size() <= m_signals.size()) {
-      break;
-    }
-  }
+  m_latch.wait();
   Logger::trace("SamplesProc", "finish waiting");
 
-  std::vector<Signal> outSignals;
-  for (uint32_t i = 0; i < m_signals[0].size(); ++i) {
-    float power = 0.0;
-    for (const auto &signals : m_signals) {
-      power += signals[i].power;
-    }
-    outSignals.push_back({m_signals[0][i].frequency, power / m_signals.size()});
+  Spectrum outSpectrum(std::move(*m_spectrum));
+  m_spectrum.reset();
+  const auto power = outSpectrum.data();
+  const auto scale = 1.0f / m_workers.size();
+  for (uint32_t j = 0; j < outSpectrum.size(); ++j) {
+    power[j] *= scale;
   }
-  m_signals.clear();
   Logger::trace("SamplesProc", "finish processing");
 
-  return outSignals;
+  return outSpectrum;
 }
@@ -2,25 +2,27 @@
 
 #include <algorithms/spectrogram.h>
 #include <config.h>
+#include <latch.h>
 #include <radio/help_structures.h>
 #include <radio/samples_processor_worker.h>
+#include <thread_pool.h>
 
 #include <complex>
-#include <condition_variable>
 #include <mutex>
+#include <optional>
 #include <vector>
 
 class SamplesProcessor {
  public:
-  SamplesProcessor(const Config& config);
+  SamplesProcessor(const Config& config, ThreadPool& pool);
   ~SamplesProcessor();
 
-  std::vector<Signal> process(const std::vector<uint8_t>& input, std::vector<std::complex<float>>& output, const FrequencyRange& frequencyRange, const int32_t frequencyOffset);
+  Spectrum process(const uint8_t* input, const uint32_t inputSize, const FrequencyRange& frequencyRange, const int32_t frequencyOffset, const SampleFormat format);
 
  private:
   std::mutex m_mutex;
-  std::condition_variable m_cv;
-  std::vector<std::vector<Signal>> m_signals;
+  Latch m_latch;
+  std::optional<Spectrum> m_spectrum;
 
   std::vector<std::unique_ptr<SamplesProcessorWorker>> m_workers;
 };
@@ -3,60 +3,34 @@
 #include <logger.h>
 #include <utils.h>
 
-SamplesProcessorWorker::SamplesProcessorWorker(const Config &config, std::mutex &outMmutex, std::condition_variable &outCv, std::vector<std::vector<Signal>> &outSignals)
-    : m_spectrogram(config), m_outMmutex(outMmutex), m_outCv(outCv), m_outSignals(outSignals), m_isWorking(true), m_thread([this]() {
-        Logger::info("SamplesWrk", "start thread id: {}", getThreadId());
-        setThreadParams("samples_worker", PRIORITY::MEDIUM);
-        while (m_isWorking) {
-          std::unique_lock<std::mutex> lock(m_mutex);
-          m_cv.wait_for(lock, std::chrono::milliseconds(10));
-          process();
-        }
-        Logger::info("SamplesWrk", "stop thread id: {}", getThreadId());
-      }) {}
+SamplesProcessorWorker::SamplesProcessorWorker(const Config &config, ThreadPool &pool, std::mutex &outMutex, Latch &outLatch, std::optional<Spectrum> &outSpectrum)
+    : m_spectrogram(config), m_pool(pool), m_outMutex(outMutex), m_outLatch(outLatch), m_outSpectrum(outSpectrum) {}
 
-SamplesProcessorWorker::~SamplesProcessorWorker() {
-  {
-    std::unique_lock<std::mutex> lock(m_mutex);
-    m_isWorking = false;
-    m_cv.notify_one();
-  }
-  m_thread.join();
-}
+SamplesProcessorWorker::~SamplesProcessorWorker() {}
 
 void SamplesProcessorWorker::push(const SamplesProcessorData &data) {
-  std::unique_lock<std::mutex> lock(m_mutex);
-  m_data.emplace(data);
-  m_cv.notify_one();
+  m_pool.submit([this, data]() { process(data); });
 }
 
-void SamplesProcessorWorker::process() {
-  if (!m_data.has_value()) {
-    return;
-  }
+void SamplesProcessorWorker::process(const SamplesProcessorData &data) {
   Logger::trace("SamplesWrk", "thread id: {}, start processing", getThreadId());
 
-  const auto inputOffset = m_data->dataOffset;
-  const auto outputOffset = inputOffset / 2;
-  const auto inputSamples = m_data->dataSize;
-  const auto outputSamples = inputSamples / 2;
-
-  if (m_shiftData.size() < outputSamples) {
-    m_shiftData = getShiftData(m_data->frequencyOffset, m_data->frequencyRange.sampleRate, outputSamples);
-    Logger::debug("SamplesWrk", "thread id: {}, shift data resized, size: {}", getThreadId(), m_shiftData.size());
-  }
-  toComplex(m_data->input + inputOffset, m_data->output + outputOffset, inputSamples);
-  Logger::trace("SamplesWrk", "thread id: {}, uint8 to complex finished", getThreadId());
-  if (m_data->frequencyOffset != 0) {
-    shift(m_data->output + outputOffset, m_shiftData, outputSamples);
-    Logger::trace("SamplesWrk", "thread id: {}, shift finished", getThreadId());
-  }
-  const auto signals = m_spectrogram.psd(m_data->frequencyRange, m_data->output + outputOffset, outputSamples);
+  auto spectrum = m_spectrogram.psd(data.frequencyRange, data.input + data.dataOffset, data.dataSize / 2, data.format, data.frequencyOffset);
   Logger::trace("SamplesProc", "thread id: {}, psd finished", getThreadId());
 
-  std::unique_lock<std::mutex> lock(m_outMmutex);
-  m_outSignals.push_back(std::move(signals));
-  m_outCv.notify_one();
-  m_data = std::nullopt;
+  // powers are summed as slices finish, the first one becomes the accumulator
+  {
+    std::unique_lock<std::mutex> lock(m_outMutex);
+    if (m_outSpectrum) {
+      const auto power = m_outSpectrum->data();
+      const auto slicePower = spectrum.data();
+      for (uint32_t i = 0; i < spectrum.size(); ++i) {
+        power[i] += slicePower[i];
+      }
+    } else {
+      m_outSpectrum.emplace(std::move(spectrum));
+    }
+  }
+  m_outLatch.countDown();
   Logger::trace("SamplesWrk", "thread id: {}, finish processing", getThreadId());
 }
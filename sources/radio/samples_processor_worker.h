@@ -2,44 +2,37 @@
 
 #include <algorithms/spectrogram.h>
 #include <config.h>
+#include <latch.h>
 #include <radio/help_structures.h>
+#include <thread_pool.h>
 
-#include <atomic>
 #include <complex>
-#include <condition_variable>
 #include <mutex>
-#include <thread>
-#include <vector>
+#include <optional>
 
 struct SamplesProcessorData {
   const uint8_t* input;
-  std::complex<float>* output;
   const FrequencyRange& frequencyRange;
   const int32_t frequencyOffset;
+  const SampleFormat format;
   const uint32_t dataOffset;
   const uint32_t dataSize;
 };
 
 class SamplesProcessorWorker {
  public:
-  SamplesProcessorWorker(const Config& config, std::mutex& outMmutex, std::condition_variable& outCv, std::vector<std::vector<Signal>>& outSignals);
+  SamplesProcessorWorker(const Config& config, ThreadPool& pool, std::mutex& outMutex, Latch& outLatch, std::optional<Spectrum>& outSpectrum);
   ~SamplesProcessorWorker();
 
   void push(const SamplesProcessorData& data);
 
  private:
-  void process();
-  std::optional<SamplesProcessorData> m_data;
+  void process(const SamplesProcessorData& data);
 
   Spectrogram m_spectrogram;
-  std::vector<std::complex<float>> m_shiftData;
+  ThreadPool& m_pool;
 
-  std::mutex& m_outMmutex;
-  std::condition_variable& m_outCv;
-  std::vector<std::vector<Signal>>& m_outSignals;
-
-  std::atomic_bool m_isWorking;
-  std::mutex m_mutex;
-  std::condition_variable m_cv;
-  std::thread m_thread;
+  std::mutex& m_outMutex;
+  Latch& m_outLatch;
+  std::optional<Spectrum>& m_outSpectrum;
 };
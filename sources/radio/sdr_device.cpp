@@ -1,24 +1,49 @@
 #include "sdr_device.h"
 
+#include <cstring>
+#include <stdexcept>
+
 constexpr auto DATA_BUFFER_SIZE = 40 * 1024 * 1024;
 constexpr auto TIME_BUFFER_SIZE = 1000;
+constexpr auto SAMPLES_POOL_SIZE = 4;
 
-SdrDevice::SdrDevice(const std::string& name) : m_performanceLogger(name), m_dataBuffer(DATA_BUFFER_SIZE), m_timeBuffer(TIME_BUFFER_SIZE) {}
+SdrDevice::SdrDevice(const std::string& name)
+    : m_performanceLogger(name), m_dataBuffer(DATA_BUFFER_SIZE, true), m_samplesPool("SamplesPool", SAMPLES_POOL_SIZE), m_timeBuffer(TIME_BUFFER_SIZE), m_isStreamFinished(false) {}
 
 void SdrDevice::waitForData() {
-  while (true) {
-    std::unique_lock<std::mutex> lock(m_mutex);
-    m_cv.wait(lock);
-    if (isDataAvailable()) {
-      break;
-    }
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_cv.wait(lock, [this]() { return m_isStreamFinished || isDataAvailable(); });
+  if (!isDataAvailable()) {
+    throw std::runtime_error("stream finished");
   }
 }
 
 bool SdrDevice::isDataAvailable() { return m_samplesSize <= m_dataBuffer.availableDataSize(); }
 
 SdrDevice::Samples SdrDevice::getStreamData() {
-  const auto timestamp = m_timeBuffer.front();
-  m_timeBuffer.pop_front();
-  return {timestamp, m_dataBuffer.pop(m_samplesSize)};
+  std::chrono::milliseconds timestamp;
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    timestamp = m_timeBuffer.front();
+    m_timeBuffer.pop_front();
+  }
+  const auto spans = m_dataBuffer.peek(m_samplesSize);
+  if (spans.second.size == 0) {
+    return {timestamp, spans.first.data, m_samplesSize, {}};
+  }
+  if (m_wrapBuffer.size() < m_samplesSize) {
+    m_wrapBuffer.resize(m_samplesSize);
+  }
+  memcpy(m_wrapBuffer.data(), spans.first.data, spans.first.size);
+  memcpy(m_wrapBuffer.data() + spans.first.size, spans.second.data, spans.second.size);
+  return {timestamp, m_wrapBuffer.data(), m_samplesSize, {}};
+}
+
+void SdrDevice::releaseStreamData() { m_dataBuffer.release(m_samplesSize); }
+
+SampleFormat SdrDevice::format() const { return SampleFormat::CU8; }
+
+void SdrDevice::pushTime(std::chrono::milliseconds time) {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_timeBuffer.push_back(time);
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <buffer_pool.h>
 #include <performance_logger.h>
 #include <radio/help_structures.h>
 #include <ring_buffer.h>
@@ -10,11 +11,17 @@
 #include <functional>
 #include <mutex>
 
+using RawBuffer = BufferPool<uint8_t>::Buffer;
+
 class SdrDevice {
  public:
+  // stream data is borrowed from the device ring buffer and valid until releaseStreamData(),
+  // readData() samples are kept alive by the pooled buffer, so they may outlive the next read
   struct Samples {
     std::chrono::milliseconds time;
-    std::vector<uint8_t> data;
+    const uint8_t* data;
+    uint32_t size;
+    RawBuffer buffer;
   };
 
   SdrDevice(const std::string& name);
@@ -27,17 +34,24 @@ class SdrDevice {
   void waitForData();
   bool isDataAvailable();
   Samples getStreamData();
+  void releaseStreamData();
 
   virtual std::string name() const = 0;
   virtual std::string serial() const = 0;
   virtual int32_t offset() const = 0;
+  virtual SampleFormat format() const;
 
  protected:
+  void pushTime(std::chrono::milliseconds time);
+
   uint32_t m_samplesSize;
   uint32_t m_readSize;
   PerformanceLogger m_performanceLogger;
   RingBuffer m_dataBuffer;
+  BufferPool<uint8_t> m_samplesPool;
   boost::circular_buffer<std::chrono::milliseconds> m_timeBuffer;
+  std::vector<uint8_t> m_wrapBuffer;
   std::mutex m_mutex;
   std::condition_variable m_cv;
+  bool m_isStreamFinished;
 };
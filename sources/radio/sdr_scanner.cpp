@@ -3,14 +3,21 @@
 #include <logger.h>
 #include <utils.h>
 
-SdrScanner::SdrScanner(const Config& config, const std::vector<UserDefinedFrequencyRange>& ranges, std::unique_ptr<SdrDevice>&& device, Mqtt& mqtt)
+constexpr auto CAPTURE_QUEUE_SIZE = 2;
+constexpr auto SWEEP_RATE_LOG_INTERVAL = std::chrono::seconds(10);
+
+SdrScanner::SdrScanner(const Config& config, const std::vector<UserDefinedFrequencyRange>& ranges, std::unique_ptr<SdrDevice>&& device, Mqtt& mqtt, ThreadPool& pool)
     : m_config(config),
       m_device(std::move(device)),
       m_dataController(config, mqtt, m_device->name()),
-      m_recorder(config, m_device->offset(), m_dataController),
+      m_recorder(config, pool, m_device->offset(), m_device->format(), m_dataController),
       m_performanceLogger("Scanner"),
       m_isRunning(true),
-      m_isManualRecordingWaiting(false) {
+      m_isManualRecordingWaiting(false),
+      m_captureQueue(CAPTURE_QUEUE_SIZE),
+      m_isCapturePaused(false),
+      m_isCapturing(false),
+      m_captureGeneration(0) {
   Logger::info("Scanner", "original frequency ranges: {}", ranges.size());
   for (const auto& range : ranges) {
     Logger::info("Scanner", "frequency range {}", range.toString());
@@ -36,15 +43,13 @@ SdrScanner::SdrScanner(const Config& config, const std::vector<UserDefinedFreque
     Logger::info("Scanner", "start thread id: {}", getThreadId());
     setThreadParams("scanner", PRIORITY::HIGH);
     try {
-      while (m_isRunning) {
-        if (splittedFrequencyRanges.size() == 1) {
+      if (splittedFrequencyRanges.size() == 1) {
+        while (m_isRunning) {
           startStream(splittedFrequencyRanges.front(), true);
-        } else {
-          for (const auto& frequencyRange : splittedFrequencyRanges) {
-            readSamples(frequencyRange);
-          }
+          checkManualRecording();
         }
-        checkManualRecording();
+      } else {
+        sweep(splittedFrequencyRanges);
       }
     } catch (const std::exception& exception) {
       Logger::error("Scanner", "exception: {}", exception.what());
@@ -56,6 +61,7 @@ SdrScanner::SdrScanner(const Config& config, const std::vector<UserDefinedFreque
 
 SdrScanner::~SdrScanner() {
   m_isRunning = false;
+  m_captureQueue.close();
   m_thread->join();
 }
 
@@ -71,24 +77,128 @@ std::string SdrScanner::deviceSerial() { return m_device->serial(); }
 void SdrScanner::startStream(const FrequencyRange& frequencyRange, bool runForever) {
   m_recorder.clear();
   m_device->startStream(frequencyRange);
-  while (m_isRunning && !m_isManualRecordingWaiting && (runForever || m_recorder.isTransmissionInProgress())) {
-    m_device->waitForData();
-    while (m_device->isDataAvailable()) {
+  auto stopStream = [this]() {
+    m_device->stopStream();
+    m_recorder.clear();
+  };
+  try {
+    while (m_isRunning && !m_isManualRecordingWaiting && (runForever || m_recorder.isTransmissionInProgress())) {
+      m_device->waitForData();
+      while (m_device->isDataAvailable()) {
+        m_performanceLogger.newSample();
+        const auto samples = m_device->getStreamData();
+        m_recorder.processSamples(samples.time, frequencyRange, samples.data, samples.size);
+        m_device->releaseStreamData();
+      }
+    }
+  } catch (const std::exception&) {
+    stopStream();
+    throw;
+  }
+  stopStream();
+}
+
+void SdrScanner::sweep(const std::vector<FrequencyRange>& frequencyRanges) {
+  // capture of the next range overlaps processing of the previous one, device is handed over only while capture is paused
+  m_scheduler = std::make_unique<SweepScheduler>(m_config, frequencyRanges);
+  m_captureThread = std::make_unique<std::thread>([this]() { capture(); });
+  auto stopCapture = [this]() {
+    m_isRunning = false;
+    m_captureQueue.close();
+    m_captureCv.notify_all();
+    m_captureThread->join();
+  };
+  uint32_t sweptRanges = 0;
+  auto lastLog = time();
+  try {
+    while (m_isRunning) {
+      auto captured = m_captureQueue.pop();
+      if (!captured) {
+        break;
+      }
+      if (captured->generation != m_captureGeneration) {
+        continue;
+      }
       m_performanceLogger.newSample();
-      auto&& samples = m_device->getStreamData();
-      m_recorder.processSamples(samples.time, frequencyRange, std::move(samples.data));
+      const auto& samples = captured->samples;
+      const auto isTransmission = samples.size != 0 && m_recorder.isTransmission(samples.time, captured->frequencyRange, samples.data, samples.size);
+      m_scheduler->report(captured->frequencyRange, isTransmission);
+      if (isTransmission) {
+        pauseCapture();
+        startStream(captured->frequencyRange, false);
+        resumeCapture();
+      }
+      if (m_isManualRecordingWaiting) {
+        pauseCapture();
+        checkManualRecording();
+        resumeCapture();
+      }
+
+      sweptRanges++;
+      const auto now = time();
+      if (SWEEP_RATE_LOG_INTERVAL <= now - lastLog) {
+        const auto seconds = std::chrono::duration_cast<std::chrono::duration<float>>(now - lastLog).count();
+        Logger::info("Scanner", "sweep rate: {:.2f} ranges/s, {:.2f} sweeps/s", sweptRanges / seconds, sweptRanges / seconds / frequencyRanges.size());
+        sweptRanges = 0;
+        lastLog = now;
+      }
     }
+  } catch (const std::exception&) {
+    stopCapture();
+    throw;
   }
-  m_device->stopStream();
-  m_recorder.clear();
+  stopCapture();
+}
+
+void SdrScanner::capture() {
+  Logger::info("Scanner", "start capture thread id: {}", getThreadId());
+  setThreadParams("capture", PRIORITY::HIGH);
+  try {
+    while (true) {
+      uint32_t generation = 0;
+      {
+        std::unique_lock<std::mutex> lock(m_captureMutex);
+        m_isCapturing = false;
+        m_captureCv.notify_all();
+        m_captureCv.wait(lock, [this]() { return !m_isCapturePaused || !m_isRunning; });
+        if (!m_isRunning) {
+          break;
+        }
+        m_isCapturing = true;
+        generation = m_captureGeneration;
+      }
+      const auto frequencyRange = m_scheduler->next();
+      if (!m_captureQueue.push({generation, frequencyRange, m_device->readData(frequencyRange)})) {
+        break;
+      }
+    }
+  } catch (const std::exception& exception) {
+    Logger::error("Scanner", "capture exception: {}", exception.what());
+    m_isRunning = false;
+    m_captureQueue.close();
+  }
+  {
+    std::unique_lock<std::mutex> lock(m_captureMutex);
+    m_isCapturing = false;
+    m_captureCv.notify_all();
+  }
+  Logger::info("Scanner", "stop capture thread id: {}", getThreadId());
 }
 
-void SdrScanner::readSamples(const FrequencyRange& frequencyRange) {
-  auto&& samples = m_device->readData(frequencyRange);
-  m_performanceLogger.newSample();
-  if (!samples.data.empty() && m_recorder.isTransmission(time(), frequencyRange, std::move(samples.data))) {
-    startStream(frequencyRange, false);
+void SdrScanner::pauseCapture() {
+  std::unique_lock<std::mutex> lock(m_captureMutex);
+  m_isCapturePaused = true;
+  m_captureGeneration++;
+  m_captureQueue.clear();
+  m_captureCv.wait(lock, [this]() { return !m_isCapturing; });
+}
+
+void SdrScanner::resumeCapture() {
+  {
+    std::unique_lock<std::mutex> lock(m_captureMutex);
+    m_isCapturePaused = false;
   }
+  m_captureCv.notify_all();
 }
 
 void SdrScanner::checkManualRecording() {
@@ -103,8 +213,15 @@ void SdrScanner::checkManualRecording() {
       m_device->waitForData();
       while (m_isRunning && m_device->isDataAvailable()) {
         m_performanceLogger.newSample();
-        auto&& samples = m_device->getStreamData();
-        m_dataController.pushTransmission(samples.time, frequencyRange, std::move(samples.data), true);
+        const auto samples = m_device->getStreamData();
+        std::vector<uint8_t> data(samples.data, samples.data + samples.size);
+        if (m_device->format() == SampleFormat::CS8) {
+          for (auto& value : data) {
+            value ^= 0b10000000;
+          }
+        }
+        m_dataController.pushTransmission(samples.time, frequencyRange, std::move(data), true);
+        m_device->releaseStreamData();
       }
     }
     Logger::info("Scanner", "finish manual recording: {}", frequencyRange.toString());
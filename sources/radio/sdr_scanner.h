@@ -1,14 +1,19 @@
 #pragma once
 
 #include <algorithms/spectrogram.h>
+#include <bounded_queue.h>
 #include <config.h>
 #include <network/data_controller.h>
 #include <performance_logger.h>
 #include <radio/recorder.h>
 #include <radio/sdr_device.h>
+#include <radio/sweep_scheduler.h>
+#include <thread_pool.h>
 
+#include <condition_variable>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <thread>
 
@@ -20,7 +25,7 @@ struct ManualRecording {
 
 class SdrScanner {
  public:
-  SdrScanner(const Config& config, const std::vector<UserDefinedFrequencyRange>& ranges, std::unique_ptr<SdrDevice>&& device, Mqtt& mqtt);
+  SdrScanner(const Config& config, const std::vector<UserDefinedFrequencyRange>& ranges, std::unique_ptr<SdrDevice>&& device, Mqtt& mqtt, ThreadPool& pool);
   ~SdrScanner();
 
   bool isRunning() const;
@@ -28,8 +33,17 @@ class SdrScanner {
   std::string deviceSerial();
 
  private:
+  struct CapturedSamples {
+    uint32_t generation;
+    FrequencyRange frequencyRange;
+    SdrDevice::Samples samples;
+  };
+
   void startStream(const FrequencyRange& frequencyRange, bool runForever);
-  void readSamples(const FrequencyRange& frequencyRange);
+  void sweep(const std::vector<FrequencyRange>& frequencyRanges);
+  void capture();
+  void pauseCapture();
+  void resumeCapture();
   void checkManualRecording();
 
   const Config& m_config;
@@ -40,5 +54,13 @@ class SdrScanner {
   std::atomic_bool m_isRunning;
   std::atomic_bool m_isManualRecordingWaiting;
   std::unique_ptr<ManualRecording> m_manualRecording;
+  std::unique_ptr<SweepScheduler> m_scheduler;
+  BoundedQueue<CapturedSamples> m_captureQueue;
+  std::mutex m_captureMutex;
+  std::condition_variable m_captureCv;
+  bool m_isCapturePaused;
+  bool m_isCapturing;
+  uint32_t m_captureGeneration;
+  std::unique_ptr<std::thread> m_captureThread;
   std::unique_ptr<std::thread> m_thread;
 };
@@ -0,0 +1,61 @@
+#include "settle_estimator.h"
+
+#include <logger.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+constexpr uint32_t SETTLE_BLOCK_SIZE = 512;
+constexpr uint32_t SETTLE_INITIAL_SIZE = 32 * SETTLE_BLOCK_SIZE;
+constexpr uint32_t SETTLE_STABLE_BLOCKS = 4;
+constexpr auto SETTLE_TOLERANCE = 1.5f;
+constexpr auto SETTLE_MARGIN = 1.25f;
+constexpr auto SETTLE_DECAY = 0.9f;
+constexpr auto PRINT_DEBUG_INTERVAL = 100;
+
+float blockPower(const uint8_t* data) {
+  float sum = 0.0f;
+  for (uint32_t i = 0; i < SETTLE_BLOCK_SIZE; ++i) {
+    const auto value = static_cast<float>(data[i]) - 127.5f;
+    sum += value * value;
+  }
+  return 10.0f * std::log10(sum / SETTLE_BLOCK_SIZE + 1e-3f);
+}
+
+uint32_t alignToBlock(float size) { return static_cast<uint32_t>(std::ceil(size / SETTLE_BLOCK_SIZE)) * SETTLE_BLOCK_SIZE; }
+
+SettleEstimator::SettleEstimator(const std::string& name, uint32_t maxSize) : m_name(name), m_maxSize(alignToBlock(maxSize)), m_size(std::min(SETTLE_INITIAL_SIZE, m_maxSize)), m_updatesCount(0) {}
+
+uint32_t SettleEstimator::size() const { return m_size; }
+
+uint32_t SettleEstimator::update(const uint8_t* data, uint32_t size) {
+  const auto blocksCount = size / SETTLE_BLOCK_SIZE;
+  if (blocksCount < 2 * SETTLE_STABLE_BLOCKS) {
+    return 0;
+  }
+  std::vector<float> powers(blocksCount);
+  for (uint32_t i = 0; i < blocksCount; ++i) {
+    powers[i] = blockPower(data + i * SETTLE_BLOCK_SIZE);
+  }
+  std::vector<float> tail(powers.begin() + blocksCount / 2, powers.end());
+  std::nth_element(tail.begin(), tail.begin() + tail.size() / 2, tail.end());
+  const auto reference = tail[tail.size() / 2];
+
+  uint32_t settledBlock = 0;
+  uint32_t stableBlocks = 0;
+  for (uint32_t i = 0; i < blocksCount / 2 && stableBlocks < SETTLE_STABLE_BLOCKS; ++i) {
+    if (std::abs(powers[i] - reference) <= SETTLE_TOLERANCE) {
+      stableBlocks++;
+    } else {
+      stableBlocks = 0;
+      settledBlock = i + 1;
+    }
+  }
+  const auto measured = settledBlock * SETTLE_BLOCK_SIZE;
+  m_size = std::min(m_maxSize, std::max(alignToBlock(measured * SETTLE_MARGIN), alignToBlock(m_size * SETTLE_DECAY)));
+  if (++m_updatesCount % PRINT_DEBUG_INTERVAL == 0) {
+    Logger::info(m_name.c_str(), "settle size: {}, last measured: {}", m_size, measured);
+  }
+  return measured;
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+// Estimates how many bytes after a retune are unsettled (PLL lock, AGC, stale transfers). Measurement compares
+// block power at the beginning of a read with the median power of its settled tail.
+class SettleEstimator {
+ public:
+  SettleEstimator(const std::string& name, uint32_t maxSize);
+
+  // bytes to read ahead of the samples after a retune
+  uint32_t size() const;
+  // measures unsettled bytes at the beginning of data, updates the estimate and returns bytes to discard
+  uint32_t update(const uint8_t* data, uint32_t size);
+
+ private:
+  const std::string m_name;
+  const uint32_t m_maxSize;
+  uint32_t m_size;
+  uint32_t m_updatesCount;
+};
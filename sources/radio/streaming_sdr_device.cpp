@@ -0,0 +1,111 @@
+#include "streaming_sdr_device.h"
+
+#include <logger.h>
+#include <utils.h>
+
+#include <stdexcept>
+
+constexpr uint32_t STREAMING_MIN_SAMPLES_READ_COUNT = 262144;
+constexpr auto PRINT_REAL_TIME_FACTOR_INTERVAL = 100;
+
+StreamingSdrDevice::StreamingSdrDevice(const Config &config, const std::string &name, bool realtime)
+    : SdrDevice(name),
+      m_config(config),
+      m_name(name),
+      m_realtime(realtime),
+      m_startTime(time()),
+      m_samplesTime(0),
+      m_readCount(0),
+      m_isStreaming(false) {}
+
+StreamingSdrDevice::~StreamingSdrDevice() { stopStream(); }
+
+void StreamingSdrDevice::startStream(const FrequencyRange &frequencyRange) {
+  setup(frequencyRange);
+  Logger::info(m_name.c_str(), "start stream, samples: {}", m_samplesSize);
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_isStreamFinished = false;
+  }
+  m_isStreaming = true;
+  m_thread = std::make_unique<std::thread>([this, frequencyRange]() {
+    setThreadParams(m_name, PRIORITY::MEDIUM);
+    std::vector<uint8_t> buffer(m_samplesSize);
+    while (m_isStreaming) {
+      const auto time = timestamp();
+      if (!read(frequencyRange, buffer.data(), buffer.size())) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_isStreamFinished = true;
+        m_cv.notify_one();
+        break;
+      }
+      if (m_realtime) {
+        if (m_dataBuffer.availableSpaceSize() < buffer.size()) {
+          Logger::warn(m_name.c_str(), "overflow, dropped: {}", buffer.size());
+          continue;
+        }
+      } else {
+        while (m_isStreaming && m_dataBuffer.availableSpaceSize() < buffer.size()) {
+          std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+      }
+      pushTime(time);
+      m_dataBuffer.push(buffer.data(), buffer.size());
+      m_performanceLogger.newSample();
+      m_cv.notify_one();
+    }
+  });
+}
+
+void StreamingSdrDevice::stopStream() {
+  if (!m_thread) {
+    return;
+  }
+  Logger::info(m_name.c_str(), "stop stream");
+  m_isStreaming = false;
+  m_thread->join();
+  m_thread.reset();
+}
+
+SdrDevice::Samples StreamingSdrDevice::readData(const FrequencyRange &frequencyRange) {
+  setup(frequencyRange);
+  const auto time = timestamp();
+  auto buffer = m_samplesPool.acquire(m_samplesSize);
+  if (!read(frequencyRange, buffer.data(), buffer.size())) {
+    throw std::runtime_error("samples finished");
+  }
+  m_performanceLogger.newSample();
+  const auto data = buffer.data();
+  return {time, data, m_samplesSize, std::move(buffer)};
+}
+
+void StreamingSdrDevice::setup(const FrequencyRange &frequencyRange) {
+  m_samplesSize = getSamplesCount(frequencyRange.sampleRate, m_config.frequencyRangeScanningTime(), STREAMING_MIN_SAMPLES_READ_COUNT);
+  m_readSize = 0;
+  m_dataBuffer.clear();
+  m_timeBuffer.clear();
+}
+
+std::chrono::microseconds StreamingSdrDevice::samplesTime() const { return m_samplesTime; }
+
+bool StreamingSdrDevice::read(const FrequencyRange &frequencyRange, uint8_t *data, uint32_t size) {
+  if (m_readCount == 0) {
+    m_startClock = std::chrono::steady_clock::now();
+  }
+  if (!fill(frequencyRange, data, size)) {
+    return false;
+  }
+  m_samplesTime += std::chrono::microseconds(static_cast<uint64_t>(size) * 500000 / frequencyRange.sampleRate);
+
+  if (m_realtime) {
+    std::this_thread::sleep_until(m_startClock + m_samplesTime);
+  }
+  if (++m_readCount % PRINT_REAL_TIME_FACTOR_INTERVAL == 0) {
+    const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_startClock);
+    const auto factor = static_cast<float>(m_samplesTime.count()) / static_cast<float>(std::max(elapsed.count(), int64_t(1)));
+    Logger::info(m_name.c_str(), "real time factor: {:.2f}, samples time: {} ms", factor, std::chrono::duration_cast<std::chrono::milliseconds>(m_samplesTime).count());
+  }
+  return true;
+}
+
+std::chrono::milliseconds StreamingSdrDevice::timestamp() const { return m_startTime + std::chrono::duration_cast<std::chrono::milliseconds>(m_samplesTime); }
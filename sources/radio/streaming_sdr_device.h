@@ -0,0 +1,44 @@
+#pragma once
+
+#include <config.h>
+#include <radio/sdr_device.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+// Base of devices whose samples are produced in software. Runs the stream thread, paces samples to real time when
+// requested (dropping chunks that do not fit into the ring buffer) or waits for free space otherwise, and logs the
+// real time factor. Derived devices only fill buffers with the next samples.
+class StreamingSdrDevice : public SdrDevice {
+ public:
+  StreamingSdrDevice(const Config& config, const std::string& name, bool realtime);
+  ~StreamingSdrDevice() override;
+
+  void startStream(const FrequencyRange& frequencyRange) override;
+  void stopStream() override;
+
+  SdrDevice::Samples readData(const FrequencyRange& frequencyRange) override;
+
+ protected:
+  virtual void setup(const FrequencyRange& frequencyRange);
+  // fills data with the next samples, returns false when there are no more samples
+  virtual bool fill(const FrequencyRange& frequencyRange, uint8_t* data, uint32_t size) = 0;
+  std::chrono::microseconds samplesTime() const;
+
+  const Config& m_config;
+
+ private:
+  bool read(const FrequencyRange& frequencyRange, uint8_t* data, uint32_t size);
+  std::chrono::milliseconds timestamp() const;
+
+  const std::string m_name;
+  const bool m_realtime;
+  const std::chrono::milliseconds m_startTime;
+  std::chrono::microseconds m_samplesTime;
+  uint32_t m_readCount;
+  std::chrono::steady_clock::time_point m_startClock;
+  std::atomic_bool m_isStreaming;
+  std::unique_ptr<std::thread> m_thread;
+};
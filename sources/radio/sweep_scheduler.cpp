@@ -0,0 +1,119 @@
+#include "sweep_scheduler.h"
+
+#include <logger.h>
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+constexpr auto ACTIVITY_DECAY = 0.8f;
+constexpr auto MIN_ACTIVITY = 0.05f;
+constexpr auto PRINT_DEBUG_INTERVAL = 1000;
+
+std::vector<FrequencyRange> sortFrequencyRanges(const std::vector<FrequencyRange>& frequencyRanges) {
+  std::vector<uint32_t> indexes(frequencyRanges.size());
+  std::iota(indexes.begin(), indexes.end(), 0);
+  std::sort(indexes.begin(), indexes.end(), [&frequencyRanges](const uint32_t a, const uint32_t b) {
+    if (frequencyRanges[a].sampleRate != frequencyRanges[b].sampleRate) {
+      return frequencyRanges[a].sampleRate < frequencyRanges[b].sampleRate;
+    }
+    return frequencyRanges[a].center() < frequencyRanges[b].center();
+  });
+  std::vector<FrequencyRange> sorted;
+  for (const auto index : indexes) {
+    sorted.push_back(frequencyRanges[index]);
+  }
+  return sorted;
+}
+
+uint32_t getMaxRevisitSlots(const Config& config, const uint32_t size) {
+  // by default every range is visited once per sweep, longer intervals leave room for extra visits of active ranges
+  if (config.maxRevisitInterval().count() == 0) {
+    return size;
+  }
+  return std::max<uint32_t>(size, config.maxRevisitInterval().count() / config.frequencyRangeScanningTime().count());
+}
+
+SweepScheduler::SweepScheduler(const Config& config, const std::vector<FrequencyRange>& frequencyRanges)
+    : m_frequencyRanges(sortFrequencyRanges(frequencyRanges)),
+      m_isActivityMode(config.sweepMode() == "activity"),
+      m_maxRevisitSlots(getMaxRevisitSlots(config, frequencyRanges.size())),
+      m_slot(0),
+      m_extraVisits(0),
+      m_index(0),
+      m_isReversed(false) {
+  if (m_frequencyRanges.empty()) {
+    throw std::runtime_error("empty frequency ranges");
+  }
+  const int64_t size = m_frequencyRanges.size();
+  for (int64_t i = 0; i < size; ++i) {
+    m_states.push_back({0.0f, i - size});
+  }
+  uint32_t sampleRateChanges = 0;
+  uint64_t frequencyJumps = 0;
+  for (uint32_t i = 1; i < m_frequencyRanges.size(); ++i) {
+    const auto& previous = m_frequencyRanges[i - 1];
+    const auto& current = m_frequencyRanges[i];
+    sampleRateChanges += previous.sampleRate != current.sampleRate;
+    frequencyJumps += std::max(previous.center(), current.center()) - std::min(previous.center(), current.center());
+  }
+  Logger::info("Scheduler", "ranges: {}, sample rate changes per sweep: {}, frequency jumps per sweep: {} Hz", m_frequencyRanges.size(), sampleRateChanges, frequencyJumps);
+  Logger::info("Scheduler", "mode: {}, max revisit interval: {} ranges", m_isActivityMode ? "activity" : "ordered", m_maxRevisitSlots);
+}
+
+FrequencyRange SweepScheduler::next() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  const auto index = m_isActivityMode ? nextActivity() : nextOrdered();
+  m_states[index].lastVisit = m_slot++;
+  if (m_slot % PRINT_DEBUG_INTERVAL == 0 && m_isActivityMode) {
+    Logger::info("Scheduler", "extra visits: {}/{}", m_extraVisits, PRINT_DEBUG_INTERVAL);
+    m_extraVisits = 0;
+  }
+  return m_frequencyRanges[index];
+}
+
+void SweepScheduler::report(const FrequencyRange& frequencyRange, bool isActive) {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  for (uint32_t i = 0; i < m_frequencyRanges.size(); ++i) {
+    if (m_frequencyRanges[i] == frequencyRange) {
+      m_states[i].activity = ACTIVITY_DECAY * m_states[i].activity + (1.0f - ACTIVITY_DECAY) * (isActive ? 1.0f : 0.0f);
+    }
+  }
+}
+
+uint32_t SweepScheduler::size() const { return m_frequencyRanges.size(); }
+
+uint32_t SweepScheduler::nextOrdered() {
+  const auto index = m_isReversed ? m_frequencyRanges.size() - 1 - m_index : m_index;
+  if (++m_index == m_frequencyRanges.size()) {
+    m_index = 0;
+    m_isReversed = !m_isReversed;
+  }
+  return index;
+}
+
+uint32_t SweepScheduler::nextActivity() {
+  std::vector<uint32_t> deadlines(m_states.size());
+  std::iota(deadlines.begin(), deadlines.end(), 0);
+  std::sort(deadlines.begin(), deadlines.end(), [this](const uint32_t a, const uint32_t b) { return m_states[a].lastVisit < m_states[b].lastVisit; });
+
+  // spare visit is allowed only if serving all ranges by deadline one slot later still meets every deadline
+  for (uint32_t k = 0; k < deadlines.size(); ++k) {
+    if (m_states[deadlines[k]].lastVisit + m_maxRevisitSlots - m_slot <= k) {
+      return deadlines.front();
+    }
+  }
+  uint32_t best = deadlines.front();
+  float bestPriority = 0.0f;
+  for (uint32_t i = 0; i < m_states.size(); ++i) {
+    const auto priority = m_states[i].activity * static_cast<float>(m_slot - m_states[i].lastVisit);
+    if (MIN_ACTIVITY <= m_states[i].activity && bestPriority < priority) {
+      best = i;
+      bestPriority = priority;
+    }
+  }
+  if (best != deadlines.front()) {
+    m_extraVisits++;
+  }
+  return best;
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <config.h>
+#include <radio/help_structures.h>
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+// Orders sweep ranges to keep retunes cheap: ranges are grouped by sample rate and sorted by center frequency,
+// and every other sweep walks the order backwards, so sample rate changes are rare and frequency jumps are short.
+// In activity mode spare visits go to ranges with recent transmissions, while every range is still visited
+// at least once per max revisit interval (earliest deadline first whenever the schedule has no slack left).
+class SweepScheduler {
+ public:
+  SweepScheduler(const Config& config, const std::vector<FrequencyRange>& frequencyRanges);
+
+  FrequencyRange next();
+  void report(const FrequencyRange& frequencyRange, bool isActive);
+  uint32_t size() const;
+
+ private:
+  struct State {
+    float activity;
+    int64_t lastVisit;
+  };
+
+  uint32_t nextOrdered();
+  uint32_t nextActivity();
+
+  const std::vector<FrequencyRange> m_frequencyRanges;
+  const bool m_isActivityMode;
+  const uint32_t m_maxRevisitSlots;
+  std::vector<State> m_states;
+  int64_t m_slot;
+  uint64_t m_extraVisits;
+  uint32_t m_index;
+  bool m_isReversed;
+  std::mutex m_mutex;
+};
@@ -1,70 +1,150 @@
 #include "ring_buffer.h"
 
 #include <logger.h>
+#include <sys/mman.h>
+#include <unistd.h>
 
 #include <cstring>
+#include <stdexcept>
 
 constexpr auto PRINT_DEBUG_INTERVAL = 100;
 
-RingBuffer::RingBuffer(uint32_t bufferSize) : m_bufferSize(bufferSize), m_writePosition(0), m_readPosition(0), m_pushDataSize(0), m_popDataSize(0), m_buffer(bufferSize) {
-  Logger::info("RingBuffer", "init, buffer size: {}", m_bufferSize);
+static uint32_t alignToPageSize(uint32_t size) {
+  const uint32_t pageSize = sysconf(_SC_PAGE_SIZE);
+  return (size + pageSize - 1) / pageSize * pageSize;
 }
 
+RingBuffer::RingBuffer(uint32_t bufferSize, bool mirrored)
+    : m_bufferSize(mirrored ? alignToPageSize(bufferSize) : bufferSize),
+      m_data(nullptr),
+      m_mirrored(false),
+      m_writePosition(0),
+      m_readPosition(0),
+      m_pushDataSize(0),
+      m_droppedDataSize(0),
+      m_popDataSize(0),
+      m_popCount(0) {
+  if (mirrored && !map()) {
+    Logger::warn("RingBuffer", "can not map mirrored buffer, fallback to plain buffer");
+  }
+  if (!m_mirrored) {
+    m_buffer.resize(m_bufferSize);
+    m_data = m_buffer.data();
+  }
+  Logger::info("RingBuffer", "init, buffer size: {}, mirrored: {}", m_bufferSize, m_mirrored);
+}
+
+RingBuffer::~RingBuffer() {
+  if (m_mirrored) {
+    munmap(m_data, 2 * static_cast<size_t>(m_bufferSize));
+  }
+}
+
+bool RingBuffer::map() {
+  const auto size = static_cast<size_t>(m_bufferSize);
+  const auto fd = memfd_create("ring_buffer", MFD_CLOEXEC);
+  if (fd < 0) {
+    return false;
+  }
+  if (ftruncate(fd, size) != 0) {
+    close(fd);
+    return false;
+  }
+  auto address = static_cast<uint8_t *>(mmap(nullptr, 2 * size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+  if (address == MAP_FAILED) {
+    close(fd);
+    return false;
+  }
+  const auto first = mmap(address, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0);
+  const auto second = mmap(address + size, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0);
+  close(fd);
+  if (first == MAP_FAILED || second == MAP_FAILED) {
+    munmap(address, 2 * size);
+    return false;
+  }
+  m_data = address;
+  m_mirrored = true;
+  return true;
+}
+
+bool RingBuffer::isMirrored() const { return m_mirrored; }
+
+uint32_t RingBuffer::bufferSize() const { return m_bufferSize; }
+
 void RingBuffer::clear() {
-  m_writePosition = 0;
-  m_readPosition = 0;
+  m_writePosition.store(0, std::memory_order_release);
+  m_readPosition.store(0, std::memory_order_release);
 }
 
 uint32_t RingBuffer::availableDataSize() const {
-  if (m_readPosition <= m_writePosition) {
-    return m_writePosition - m_readPosition;
-  } else {
-    return m_bufferSize - (m_readPosition - m_writePosition);
-  }
+  const auto readPosition = m_readPosition.load(std::memory_order_acquire);
+  const auto writePosition = m_writePosition.load(std::memory_order_acquire);
+  return writePosition - readPosition;
 }
 
 uint32_t RingBuffer::availableSpaceSize() const { return m_bufferSize - availableDataSize(); }
 
-void RingBuffer::push(uint8_t *data, uint32_t size) {
-  m_pushDataSize += size;
+uint64_t RingBuffer::droppedDataSize() const { return m_droppedDataSize.load(std::memory_order_relaxed); }
 
-  bool overflow = false;
-  if (availableSpaceSize() < size) {
-    Logger::warn("RingBuffer", "overflow");
-    overflow = true;
+void RingBuffer::push(const uint8_t *data, uint32_t size) {
+  m_pushDataSize.fetch_add(size, std::memory_order_relaxed);
+
+  const auto writePosition = m_writePosition.load(std::memory_order_relaxed);
+  const auto readPosition = m_readPosition.load(std::memory_order_acquire);
+  if (m_bufferSize - (writePosition - readPosition) < size) {
+    m_droppedDataSize.fetch_add(size, std::memory_order_relaxed);
+    Logger::warn("RingBuffer", "overflow, dropped: {}", size);
+    return;
   }
-  if (m_writePosition + size < m_bufferSize) {
-    memcpy(m_buffer.data() + m_writePosition, data, size);
-    m_writePosition += size;
+
+  const auto offset = writePosition % m_bufferSize;
+  if (m_mirrored || offset + size <= m_bufferSize) {
+    memcpy(m_data + offset, data, size);
   } else {
-    const auto endSize = m_bufferSize - m_writePosition;
-    memcpy(m_buffer.data() + m_writePosition, data, endSize);
-    memcpy(m_buffer.data(), data + endSize, size - endSize);
-    m_writePosition = (m_writePosition + size) % m_bufferSize;
+    const auto endSize = m_bufferSize - offset;
+    memcpy(m_data + offset, data, endSize);
+    memcpy(m_data, data + endSize, size - endSize);
+  }
+  m_writePosition.store(writePosition + size, std::memory_order_release);
+}
+
+RingBuffer::Spans RingBuffer::peek(uint32_t size) const {
+  const auto readPosition = m_readPosition.load(std::memory_order_relaxed);
+  const auto writePosition = m_writePosition.load(std::memory_order_acquire);
+  if (writePosition - readPosition < size) {
+    throw std::runtime_error("ring buffer underflow");
   }
-  if (overflow) {
-    m_readPosition = m_writePosition.load();
+
+  const auto offset = readPosition % m_bufferSize;
+  if (m_mirrored || offset + size <= m_bufferSize) {
+    return {{m_data + offset, size}, {nullptr, 0}};
+  } else {
+    const auto endSize = static_cast<uint32_t>(m_bufferSize - offset);
+    return {{m_data + offset, endSize}, {m_data, size - endSize}};
   }
 }
 
-std::vector<uint8_t> RingBuffer::pop(uint32_t size) {
+void RingBuffer::release(uint32_t size) {
   m_popDataSize += size;
   m_popCount++;
 
   if (m_popCount % PRINT_DEBUG_INTERVAL == 0) {
-    const auto ratio = static_cast<float>(m_popDataSize) / static_cast<float>(m_pushDataSize);
-    Logger::info("RingBuffer", "pop/push: {}/{} ({:.2f})", m_popDataSize, m_pushDataSize, ratio);
+    const auto pushDataSize = m_pushDataSize.load(std::memory_order_relaxed);
+    const auto ratio = static_cast<float>(m_popDataSize) / static_cast<float>(pushDataSize);
+    Logger::info("RingBuffer", "pop/push: {}/{} ({:.2f}), dropped: {}", m_popDataSize, pushDataSize, ratio, droppedDataSize());
   }
 
+  const auto readPosition = m_readPosition.load(std::memory_order_relaxed);
+  m_readPosition.store(readPosition + size, std::memory_order_release);
+}
+
+std::vector<uint8_t> RingBuffer::pop(uint32_t size) {
+  const auto spans = peek(size);
   std::vector<uint8_t> data(size);
-  if (m_readPosition + size < m_bufferSize) {
-    memcpy(data.data(), m_buffer.data() + m_readPosition, size);
-    m_readPosition += size;
-  } else {
-    const auto endSize = m_bufferSize - m_readPosition;
-    memcpy(data.data(), m_buffer.data() + m_readPosition, endSize);
-    memcpy(data.data() + endSize, m_buffer.data(), size - endSize);
-    m_readPosition = (m_readPosition + size) % m_bufferSize;
+  memcpy(data.data(), spans.first.data, spans.first.size);
+  if (spans.second.size) {
+    memcpy(data.data() + spans.first.size, spans.second.data, spans.second.size);
   }
+  release(size);
   return data;
 }
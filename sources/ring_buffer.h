@@ -4,22 +4,47 @@
 #include <cstdint>
 #include <vector>
 
+// Single-producer/single-consumer ring buffer. push() may be called only from the producer thread,
+// peek()/release()/pop() only from the consumer thread. clear() requires the producer to be stopped.
+// In mirrored mode the same memory is mapped twice back-to-back, so every read is a single contiguous span.
 class RingBuffer {
  public:
-  RingBuffer(uint32_t bufferSize);
+  struct Span {
+    const uint8_t* data;
+    uint32_t size;
+  };
 
+  // borrowed view of buffered data, second span is not empty only at the wrap point
+  struct Spans {
+    Span first;
+    Span second;
+  };
+
+  RingBuffer(uint32_t bufferSize, bool mirrored = false);
+  ~RingBuffer();
+
+  bool isMirrored() const;
+  uint32_t bufferSize() const;
   void clear();
   uint32_t availableDataSize() const;
   uint32_t availableSpaceSize() const;
-  void push(uint8_t* data, uint32_t size);
+  uint64_t droppedDataSize() const;
+  void push(const uint8_t* data, uint32_t size);
+  Spans peek(uint32_t size) const;
+  void release(uint32_t size);
   std::vector<uint8_t> pop(uint32_t size);
 
  private:
+  bool map();
+
   const uint32_t m_bufferSize;
-  std::atomic_uint32_t m_writePosition;
-  std::atomic_uint32_t m_readPosition;
-  uint64_t m_pushDataSize;
-  uint64_t m_popDataSize;
   std::vector<uint8_t> m_buffer;
+  uint8_t* m_data;
+  bool m_mirrored;
+  alignas(64) std::atomic_uint64_t m_writePosition;
+  alignas(64) std::atomic_uint64_t m_readPosition;
+  std::atomic_uint64_t m_pushDataSize;
+  std::atomic_uint64_t m_droppedDataSize;
+  uint64_t m_popDataSize;
   uint32_t m_popCount;
 };
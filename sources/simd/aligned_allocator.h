@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+// Allocator for vectors read by simd kernels, keeps data aligned to a full AVX-512 register.
+template <typename T, std::size_t ALIGNMENT = 64>
+struct AlignedAllocator {
+  using value_type = T;
+
+  template <typename U>
+  struct rebind {
+    using other = AlignedAllocator<U, ALIGNMENT>;
+  };
+
+  AlignedAllocator() = default;
+  template <typename U>
+  AlignedAllocator(const AlignedAllocator<U, ALIGNMENT>&) {}
+
+  T* allocate(std::size_t size) { return static_cast<T*>(::operator new(size * sizeof(T), std::align_val_t(ALIGNMENT))); }
+  void deallocate(T* data, std::size_t) { ::operator delete(data, std::align_val_t(ALIGNMENT)); }
+
+  template <typename U>
+  bool operator==(const AlignedAllocator<U, ALIGNMENT>&) const {
+    return true;
+  }
+  template <typename U>
+  bool operator!=(const AlignedAllocator<U, ALIGNMENT>&) const {
+    return false;
+  }
+};
+
+template <typename T>
+using AlignedVector = std::vector<T, AlignedAllocator<T>>;
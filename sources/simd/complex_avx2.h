@@ -0,0 +1,20 @@
+#pragma once
+
+#include <simd/cpu_features.h>
+
+#include <complex>
+
+// Written out to avoid the nan checks of std::complex multiplication, which block vectorization.
+inline std::complex<float> multiplyComplex(std::complex<float> a, std::complex<float> b) {
+  return {a.real() * b.real() - a.imag() * b.imag(), a.real() * b.imag() + a.imag() * b.real()};
+}
+
+#ifdef SIMD_X86
+#include <immintrin.h>
+
+// Multiplies 4 interleaved complex floats of a by 4 of b.
+__attribute__((target("avx2,fma"))) inline __m256 multiplyComplexAvx2(__m256 a, __m256 b) {
+  const auto swapped = _mm256_permute_ps(a, 0b10110001);
+  return _mm256_fmaddsub_ps(a, _mm256_moveldup_ps(b), _mm256_mul_ps(swapped, _mm256_movehdup_ps(b)));
+}
+#endif
@@ -0,0 +1,174 @@
+#include "convert.h"
+
+#include <simd/complex_avx2.h>
+
+#include <array>
+
+constexpr auto CONVERT_SCALE = 1.0f / 127.5f;
+constexpr auto CONVERT_OFFSET = -1.0f;
+constexpr uint8_t CS8_MASK = 0b10000000;
+
+using ConvertFunction = void (*)(const uint8_t*, std::complex<float>*, uint32_t, SampleFormat);
+using ConvertShiftWindowFunction = void (*)(const uint8_t*, const std::complex<float>*, const float*, std::complex<float>*, uint32_t, SampleFormat);
+
+uint8_t formatMask(SampleFormat format) { return format == SampleFormat::CS8 ? CS8_MASK : 0; }
+
+const std::array<float, 256>& convertCache() {
+  static const auto cache = []() {
+    std::array<float, 256> cache;
+    for (int i = 0; i < 256; ++i) {
+      cache[i] = (static_cast<float>(i) - 127.5f) / 127.5f;
+    }
+    return cache;
+  }();
+  return cache;
+}
+
+void convertScalar(const uint8_t* input, std::complex<float>* output, uint32_t size, SampleFormat format) {
+  const auto& cache = convertCache();
+  const auto mask = formatMask(format);
+  auto out = reinterpret_cast<float*>(output);
+  for (uint32_t i = 0; i < size; ++i) {
+    out[i] = cache[input[i] ^ mask];
+  }
+}
+
+void convertShiftWindowScalar(const uint8_t* input, const std::complex<float>* shift, const float* window, std::complex<float>* output, uint32_t samples, SampleFormat format) {
+  const auto& cache = convertCache();
+  const auto mask = formatMask(format);
+  for (uint32_t i = 0; i < samples; ++i) {
+    std::complex<float> value(cache[input[2 * i] ^ mask], cache[input[2 * i + 1] ^ mask]);
+    if (shift) {
+      value *= shift[i];
+    }
+    output[i] = value * window[i];
+  }
+}
+
+#ifdef SIMD_X86
+__attribute__((target("sse2"))) inline __m128 toFloatSse2(__m128i value, __m128 scale, __m128 offset) { return _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(value), scale), offset); }
+
+__attribute__((target("avx2,fma"))) inline __m256 toFloatAvx2(__m128i value, __m256 scale, __m256 offset) {
+  return _mm256_fmadd_ps(_mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(value)), scale, offset);
+}
+
+// full-mask variants, the unmasked intrinsics trigger false maybe-uninitialized warnings in gcc 12
+__attribute__((target("avx512f"))) inline __m512 toFloatAvx512(const uint8_t* input, __m128i mask, __m512 scale, __m512 offset) {
+  const auto value = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(input)), mask);
+  const auto integers = _mm512_maskz_cvtepu8_epi32(0xFFFF, value);
+  return _mm512_fmadd_ps(_mm512_maskz_cvtepi32_ps(0xFFFF, integers), scale, offset);
+}
+
+__attribute__((target("sse2"))) void convertSse2(const uint8_t* input, std::complex<float>* output, uint32_t size, SampleFormat format) {
+  auto out = reinterpret_cast<float*>(output);
+  const auto mask = _mm_set1_epi8(static_cast<char>(formatMask(format)));
+  const auto zero = _mm_setzero_si128();
+  const auto scale = _mm_set1_ps(CONVERT_SCALE);
+  const auto offset = _mm_set1_ps(CONVERT_OFFSET);
+  uint32_t i = 0;
+  for (; i + 16 <= size; i += 16) {
+    const auto bytes = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i)), mask);
+    const auto low = _mm_unpacklo_epi8(bytes, zero);
+    const auto high = _mm_unpackhi_epi8(bytes, zero);
+    _mm_storeu_ps(out + i, toFloatSse2(_mm_unpacklo_epi16(low, zero), scale, offset));
+    _mm_storeu_ps(out + i + 4, toFloatSse2(_mm_unpackhi_epi16(low, zero), scale, offset));
+    _mm_storeu_ps(out + i + 8, toFloatSse2(_mm_unpacklo_epi16(high, zero), scale, offset));
+    _mm_storeu_ps(out + i + 12, toFloatSse2(_mm_unpackhi_epi16(high, zero), scale, offset));
+  }
+  convertScalar(input + i, output + i / 2, size - i, format);
+}
+
+__attribute__((target("avx2,fma"))) void convertAvx2(const uint8_t* input, std::complex<float>* output, uint32_t size, SampleFormat format) {
+  auto out = reinterpret_cast<float*>(output);
+  const auto mask = _mm_set1_epi8(static_cast<char>(formatMask(format)));
+  const auto scale = _mm256_set1_ps(CONVERT_SCALE);
+  const auto offset = _mm256_set1_ps(CONVERT_OFFSET);
+  uint32_t i = 0;
+  for (; i + 32 <= size; i += 32) {
+    const auto low = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i)), mask);
+    const auto high = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i + 16)), mask);
+    _mm256_storeu_ps(out + i, toFloatAvx2(low, scale, offset));
+    _mm256_storeu_ps(out + i + 8, toFloatAvx2(_mm_srli_si128(low, 8), scale, offset));
+    _mm256_storeu_ps(out + i + 16, toFloatAvx2(high, scale, offset));
+    _mm256_storeu_ps(out + i + 24, toFloatAvx2(_mm_srli_si128(high, 8), scale, offset));
+  }
+  convertScalar(input + i, output + i / 2, size - i, format);
+}
+
+__attribute__((target("avx512f"))) void convertAvx512(const uint8_t* input, std::complex<float>* output, uint32_t size, SampleFormat format) {
+  auto out = reinterpret_cast<float*>(output);
+  const auto mask = _mm_set1_epi8(static_cast<char>(formatMask(format)));
+  const auto scale = _mm512_set1_ps(CONVERT_SCALE);
+  const auto offset = _mm512_set1_ps(CONVERT_OFFSET);
+  uint32_t i = 0;
+  for (; i + 64 <= size; i += 64) {
+    _mm512_storeu_ps(out + i, toFloatAvx512(input + i, mask, scale, offset));
+    _mm512_storeu_ps(out + i + 16, toFloatAvx512(input + i + 16, mask, scale, offset));
+    _mm512_storeu_ps(out + i + 32, toFloatAvx512(input + i + 32, mask, scale, offset));
+    _mm512_storeu_ps(out + i + 48, toFloatAvx512(input + i + 48, mask, scale, offset));
+  }
+  convertScalar(input + i, output + i / 2, size - i, format);
+}
+
+// 4 samples per step: bytes to floats, complex multiply by the shift factors, then scale by the duplicated window
+__attribute__((target("avx2,fma"))) void convertShiftWindowAvx2(
+    const uint8_t* input,
+    const std::complex<float>* shift,
+    const float* window,
+    std::complex<float>* output,
+    uint32_t samples,
+    SampleFormat format) {
+  auto out = reinterpret_cast<float*>(output);
+  auto factors = reinterpret_cast<const float*>(shift);
+  const auto mask = _mm_set1_epi8(static_cast<char>(formatMask(format)));
+  const auto scale = _mm256_set1_ps(CONVERT_SCALE);
+  const auto offset = _mm256_set1_ps(CONVERT_OFFSET);
+  const auto duplicate = _mm256_setr_epi32(0, 0, 1, 1, 2, 2, 3, 3);
+  uint32_t i = 0;
+  for (; i + 4 <= samples; i += 4) {
+    const auto bytes = _mm_xor_si128(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(input + 2 * i)), mask);
+    auto value = toFloatAvx2(bytes, scale, offset);
+    if (factors) {
+      value = multiplyComplexAvx2(value, _mm256_loadu_ps(factors + 2 * i));
+    }
+    const auto coefficients = _mm256_permutevar8x32_ps(_mm256_castps128_ps256(_mm_loadu_ps(window + i)), duplicate);
+    _mm256_storeu_ps(out + 2 * i, _mm256_mul_ps(value, coefficients));
+  }
+  convertShiftWindowScalar(input + 2 * i, shift ? shift + i : nullptr, window + i, output + i, samples - i, format);
+}
+#endif
+
+ConvertFunction selectConvert() {
+#ifdef SIMD_X86
+  switch (simdLevel()) {
+    case SimdLevel::AVX512:
+      return convertAvx512;
+    case SimdLevel::AVX2:
+      return convertAvx2;
+    case SimdLevel::SSE2:
+      return convertSse2;
+    default:
+      break;
+  }
+#endif
+  return convertScalar;
+}
+
+void convert(const uint8_t* input, std::complex<float>* output, uint32_t size, SampleFormat format) {
+  static const auto function = selectConvert();
+  function(input, output, size, format);
+}
+
+ConvertShiftWindowFunction selectConvertShiftWindow() {
+#ifdef SIMD_X86
+  if (SimdLevel::AVX2 <= simdLevel()) {
+    return convertShiftWindowAvx2;
+  }
+#endif
+  return convertShiftWindowScalar;
+}
+
+void convertShiftWindow(const uint8_t* input, const std::complex<float>* shift, const float* window, std::complex<float>* output, uint32_t samples, SampleFormat format) {
+  static const auto function = selectConvertShiftWindow();
+  function(input, shift, window, output, samples, format);
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <radio/help_structures.h>
+#include <simd/cpu_features.h>
+
+#include <complex>
+#include <cstdint>
+
+// Converts interleaved 8-bit IQ bytes to complex float in range [-1, 1], size is in bytes. cs8 bytes give
+// the same values as the cu8 bytes they would be flipped to, so devices do not need to rewrite their buffers.
+void convert(const uint8_t* input, std::complex<float>* output, uint32_t size, SampleFormat format);
+
+void convertScalar(const uint8_t* input, std::complex<float>* output, uint32_t size, SampleFormat format);
+#ifdef SIMD_X86
+void convertSse2(const uint8_t* input, std::complex<float>* output, uint32_t size, SampleFormat format);
+void convertAvx2(const uint8_t* input, std::complex<float>* output, uint32_t size, SampleFormat format);
+void convertAvx512(const uint8_t* input, std::complex<float>* output, uint32_t size, SampleFormat format);
+#endif
+
+// Converts samples (2 * samples bytes), multiplies them by shift factors (nullptr to skip) and window coefficients
+// in one pass, so fft input is produced straight from device bytes without intermediate buffers.
+void convertShiftWindow(const uint8_t* input, const std::complex<float>* shift, const float* window, std::complex<float>* output, uint32_t samples, SampleFormat format);
+
+void convertShiftWindowScalar(const uint8_t* input, const std::complex<float>* shift, const float* window, std::complex<float>* output, uint32_t samples, SampleFormat format);
+#ifdef SIMD_X86
+void convertShiftWindowAvx2(const uint8_t* input, const std::complex<float>* shift, const float* window, std::complex<float>* output, uint32_t samples, SampleFormat format);
+#endif
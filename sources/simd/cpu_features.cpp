@@ -0,0 +1,41 @@
+#include "cpu_features.h"
+
+#include <logger.h>
+
+SimdLevel detectSimdLevel() {
+#ifdef SIMD_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) {
+    return SimdLevel::AVX512;
+  }
+  if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+    return SimdLevel::AVX2;
+  }
+  if (__builtin_cpu_supports("sse2")) {
+    return SimdLevel::SSE2;
+  }
+#endif
+  return SimdLevel::SCALAR;
+}
+
+SimdLevel simdLevel() {
+  static const SimdLevel level = []() {
+    const auto level = detectSimdLevel();
+    Logger::info("simd", "detected: {}", simdLevelToString(level));
+    return level;
+  }();
+  return level;
+}
+
+std::string simdLevelToString(SimdLevel level) {
+  switch (level) {
+    case SimdLevel::AVX512:
+      return "avx512";
+    case SimdLevel::AVX2:
+      return "avx2";
+    case SimdLevel::SSE2:
+      return "sse2";
+    default:
+      return "scalar";
+  }
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <string>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define SIMD_X86
+#endif
+
+// Instruction set extensions usable by hand written kernels, detected once at runtime. Kernels for other
+// architectures are left to compiler auto-vectorization of the scalar versions.
+enum class SimdLevel { SCALAR = 0, SSE2 = 1, AVX2 = 2, AVX512 = 3 };
+
+SimdLevel simdLevel();
+std::string simdLevelToString(SimdLevel level);
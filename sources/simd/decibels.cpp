@@ -0,0 +1,74 @@
+#include "decibels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#ifdef SIMD_X86
+#include <immintrin.h>
+#endif
+
+// minimax fit of log2(1 + t) = t * (C1 + t * (C2 + t * C3)) for t in [0, 1)
+constexpr auto LOG2_C1 = 1.42458075f;
+constexpr auto LOG2_C2 = -0.589164112f;
+constexpr auto LOG2_C3 = 0.165353027f;
+constexpr auto DECIBELS_PER_OCTAVE = 3.01029996f;  // 10 * log10(2)
+constexpr auto MIN_POWER = std::numeric_limits<float>::min();
+
+using DecibelsFunction = void (*)(const float*, float*, uint32_t, float);
+
+inline float fastLog2(float value) {
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  const auto exponent = static_cast<float>(static_cast<int32_t>(bits >> 23) - 127);
+  bits = (bits & 0x007FFFFF) | 0x3F800000;
+  float mantissa;
+  memcpy(&mantissa, &bits, sizeof(mantissa));
+  const auto t = mantissa - 1.0f;
+  return exponent + t * (LOG2_C1 + t * (LOG2_C2 + t * LOG2_C3));
+}
+
+void toDecibelsScalar(const float* input, float* output, uint32_t size, float scale) {
+  const auto offset = 10.0f * std::log10(scale);
+  for (uint32_t i = 0; i < size; ++i) {
+    output[i] = DECIBELS_PER_OCTAVE * fastLog2(std::max(input[i], MIN_POWER)) + offset;
+  }
+}
+
+#ifdef SIMD_X86
+__attribute__((target("avx2,fma"))) void toDecibelsAvx2(const float* input, float* output, uint32_t size, float scale) {
+  const auto minPower = _mm256_set1_ps(MIN_POWER);
+  const auto mantissaMask = _mm256_set1_epi32(0x007FFFFF);
+  const auto one = _mm256_set1_epi32(0x3F800000);
+  const auto bias = _mm256_set1_epi32(127);
+  const auto c1 = _mm256_set1_ps(LOG2_C1);
+  const auto c2 = _mm256_set1_ps(LOG2_C2);
+  const auto c3 = _mm256_set1_ps(LOG2_C3);
+  const auto multiplier = _mm256_set1_ps(DECIBELS_PER_OCTAVE);
+  const auto offset = _mm256_set1_ps(10.0f * std::log10(scale));
+  uint32_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    const auto bits = _mm256_castps_si256(_mm256_max_ps(_mm256_loadu_ps(input + i), minPower));
+    const auto exponent = _mm256_cvtepi32_ps(_mm256_sub_epi32(_mm256_srli_epi32(bits, 23), bias));
+    const auto t = _mm256_sub_ps(_mm256_castsi256_ps(_mm256_or_si256(_mm256_and_si256(bits, mantissaMask), one)), _mm256_castsi256_ps(one));
+    const auto polynomial = _mm256_mul_ps(t, _mm256_fmadd_ps(t, _mm256_fmadd_ps(t, c3, c2), c1));
+    _mm256_storeu_ps(output + i, _mm256_fmadd_ps(_mm256_add_ps(exponent, polynomial), multiplier, offset));
+  }
+  toDecibelsScalar(input + i, output + i, size - i, scale);
+}
+#endif
+
+DecibelsFunction selectDecibels() {
+#ifdef SIMD_X86
+  if (SimdLevel::AVX2 <= simdLevel()) {
+    return toDecibelsAvx2;
+  }
+#endif
+  return toDecibelsScalar;
+}
+
+void toDecibels(const float* input, float* output, uint32_t size, float scale) {
+  static const auto function = selectDecibels();
+  function(input, output, size, scale);
+}
@@ -0,0 +1,91 @@
+#include "fir.h"
+
+#ifdef SIMD_X86
+#include <immintrin.h>
+#endif
+
+using FirFunction = void (*)(const std::complex<float>*, const float*, uint32_t, uint32_t, std::complex<float>*, uint32_t);
+
+void firScalar(const std::complex<float>* input, const float* taps, uint32_t tapsSize, uint32_t stride, std::complex<float>* output, uint32_t size) {
+  for (uint32_t n = 0; n < size; ++n) {
+    const auto* window = input + n * stride;
+    float real = 0.0f;
+    float imag = 0.0f;
+    for (uint32_t t = 0; t < tapsSize; ++t) {
+      real += taps[t] * window[t].real();
+      imag += taps[t] * window[t].imag();
+    }
+    output[n] = {real, imag};
+  }
+}
+
+#ifdef SIMD_X86
+// without decimation neighbouring outputs share samples, so 8 outputs are accumulated at once with one tap broadcast
+__attribute__((target("avx2,fma"))) void firAvx2Consecutive(const std::complex<float>* input, const float* taps, uint32_t tapsSize, std::complex<float>* output, uint32_t size) {
+  uint32_t n = 0;
+  for (; n + 8 <= size; n += 8) {
+    const auto* window = reinterpret_cast<const float*>(input + n);
+    auto low = _mm256_setzero_ps();
+    auto high = _mm256_setzero_ps();
+    for (uint32_t t = 0; t < tapsSize; ++t) {
+      const auto tap = _mm256_set1_ps(taps[t]);
+      low = _mm256_fmadd_ps(tap, _mm256_loadu_ps(window + 2 * t), low);
+      high = _mm256_fmadd_ps(tap, _mm256_loadu_ps(window + 2 * t + 8), high);
+    }
+    _mm256_storeu_ps(reinterpret_cast<float*>(output + n), low);
+    _mm256_storeu_ps(reinterpret_cast<float*>(output + n + 4), high);
+  }
+  firScalar(input + n, taps, tapsSize, 1, output + n, size - n);
+}
+
+// with decimation every output is a dot product over contiguous samples, so any stride loads the same way
+__attribute__((target("avx2,fma"))) void firAvx2(
+    const std::complex<float>* input,
+    const float* taps,
+    uint32_t tapsSize,
+    uint32_t stride,
+    std::complex<float>* output,
+    uint32_t size) {
+  if (stride == 1 && 8 <= size) {
+    firAvx2Consecutive(input, taps, tapsSize, output, size);
+    return;
+  }
+  const auto lowTaps = _mm256_setr_epi32(0, 0, 1, 1, 2, 2, 3, 3);
+  const auto highTaps = _mm256_setr_epi32(4, 4, 5, 5, 6, 6, 7, 7);
+  for (uint32_t n = 0; n < size; ++n) {
+    const auto* window = reinterpret_cast<const float*>(input + n * stride);
+    auto low = _mm256_setzero_ps();
+    auto high = _mm256_setzero_ps();
+    uint32_t t = 0;
+    for (; t + 8 <= tapsSize; t += 8) {
+      const auto tapsBlock = _mm256_loadu_ps(taps + t);
+      low = _mm256_fmadd_ps(_mm256_permutevar8x32_ps(tapsBlock, lowTaps), _mm256_loadu_ps(window + 2 * t), low);
+      high = _mm256_fmadd_ps(_mm256_permutevar8x32_ps(tapsBlock, highTaps), _mm256_loadu_ps(window + 2 * t + 8), high);
+    }
+    const auto sum256 = _mm256_add_ps(low, high);
+    auto sum = _mm_add_ps(_mm256_castps256_ps128(sum256), _mm256_extractf128_ps(sum256, 1));
+    sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+    alignas(16) float result[4];
+    _mm_store_ps(result, sum);
+    for (; t < tapsSize; ++t) {
+      result[0] += taps[t] * window[2 * t];
+      result[1] += taps[t] * window[2 * t + 1];
+    }
+    output[n] = {result[0], result[1]};
+  }
+}
+#endif
+
+FirFunction selectFir() {
+#ifdef SIMD_X86
+  if (SimdLevel::AVX2 <= simdLevel()) {
+    return firAvx2;
+  }
+#endif
+  return firScalar;
+}
+
+void fir(const std::complex<float>* input, const float* taps, uint32_t tapsSize, uint32_t stride, std::complex<float>* output, uint32_t size) {
+  static const auto function = selectFir();
+  function(input, taps, tapsSize, stride, output, size);
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <simd/cpu_features.h>
+
+#include <complex>
+#include <cstdint>
+
+// Filters input with real taps and keeps every stride-th output: output[n] = sum of taps[t] * input[n * stride + t].
+// Taps are applied in the given order, input has to hold (size - 1) * stride + tapsSize samples.
+void fir(const std::complex<float>* input, const float* taps, uint32_t tapsSize, uint32_t stride, std::complex<float>* output, uint32_t size);
+
+void firScalar(const std::complex<float>* input, const float* taps, uint32_t tapsSize, uint32_t stride, std::complex<float>* output, uint32_t size);
+#ifdef SIMD_X86
+void firAvx2(const std::complex<float>* input, const float* taps, uint32_t tapsSize, uint32_t stride, std::complex<float>* output, uint32_t size);
+#endif
@@ -0,0 +1,58 @@
+#include "rotate.h"
+
+#include <simd/complex_avx2.h>
+
+using RotateFunction = std::complex<float> (*)(const std::complex<float>*, std::complex<float>*, uint32_t, std::complex<float>, std::complex<float>);
+
+std::complex<float> rotateScalar(const std::complex<float>* input, std::complex<float>* output, uint32_t size, std::complex<float> phase, std::complex<float> step) {
+  for (uint32_t i = 0; i < size; ++i) {
+    output[i] = multiplyComplex(input[i], phase);
+    phase = multiplyComplex(phase, step);
+  }
+  return phase;
+}
+
+#ifdef SIMD_X86
+__attribute__((target("avx2,fma"))) std::complex<float> rotateAvx2(
+    const std::complex<float>* input,
+    std::complex<float>* output,
+    uint32_t size,
+    std::complex<float> phase,
+    std::complex<float> step) {
+  if (size < 4) {
+    return rotateScalar(input, output, size, phase, step);
+  }
+  alignas(32) std::complex<float> phases[4];
+  phases[0] = phase;
+  for (int i = 1; i < 4; ++i) {
+    phases[i] = multiplyComplex(phases[i - 1], step);
+  }
+  const auto step2 = multiplyComplex(step, step);
+  const auto step4 = multiplyComplex(step2, step2);
+  auto phasesVector = _mm256_load_ps(reinterpret_cast<const float*>(phases));
+  const auto stepVector = _mm256_setr_ps(step4.real(), step4.imag(), step4.real(), step4.imag(), step4.real(), step4.imag(), step4.real(), step4.imag());
+  auto in = reinterpret_cast<const float*>(input);
+  auto out = reinterpret_cast<float*>(output);
+  uint32_t i = 0;
+  for (; i + 4 <= size; i += 4) {
+    _mm256_storeu_ps(out + 2 * i, multiplyComplexAvx2(_mm256_loadu_ps(in + 2 * i), phasesVector));
+    phasesVector = multiplyComplexAvx2(phasesVector, stepVector);
+  }
+  _mm256_store_ps(reinterpret_cast<float*>(phases), phasesVector);
+  return rotateScalar(input + i, output + i, size - i, phases[0], step);
+}
+#endif
+
+RotateFunction selectRotate() {
+#ifdef SIMD_X86
+  if (SimdLevel::AVX2 <= simdLevel()) {
+    return rotateAvx2;
+  }
+#endif
+  return rotateScalar;
+}
+
+std::complex<float> rotate(const std::complex<float>* input, std::complex<float>* output, uint32_t size, std::complex<float> phase, std::complex<float> step) {
+  static const auto function = selectRotate();
+  return function(input, output, size, phase, step);
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <simd/cpu_features.h>
+
+#include <complex>
+#include <cstdint>
+
+// Multiplies input by phase, phase * step, phase * step^2, ... and returns the phase following the last sample.
+// Rounding errors accumulate with size, so callers should restart from an exact phase every few thousand samples.
+std::complex<float> rotate(const std::complex<float>* input, std::complex<float>* output, uint32_t size, std::complex<float> phase, std::complex<float> step);
+
+std::complex<float> rotateScalar(const std::complex<float>* input, std::complex<float>* output, uint32_t size, std::complex<float> phase, std::complex<float> step);
+#ifdef SIMD_X86
+std::complex<float> rotateAvx2(const std::complex<float>* input, std::complex<float>* output, uint32_t size, std::complex<float> phase, std::complex<float> step);
+#endif
@@ -0,0 +1,123 @@
+#include "thread_pool.h"
+
+#include <logger.h>
+#include <utils.h>
+
+constexpr auto PRINT_STATISTICS_INTERVAL = std::chrono::seconds(10);
+
+thread_local const ThreadPool* currentPool = nullptr;
+thread_local uint32_t currentQueue = 0;
+
+ThreadPool::ThreadPool(const std::string& name, uint32_t threadsCount) : m_name(name), m_nextQueue(0), m_pendingTasks(0), m_isRunning(true), m_lastLog(std::chrono::steady_clock::now()) {
+  for (uint32_t i = 0; i < std::max(1u, threadsCount); ++i) {
+    m_queues.push_back(std::make_unique<Queue>());
+  }
+  for (uint32_t i = 0; i < m_queues.size(); ++i) {
+    m_threads.emplace_back([this, i]() { run(i); });
+  }
+  Logger::info(m_name.c_str(), "threads: {}", m_threads.size());
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_isRunning = false;
+    m_cv.notify_all();
+  }
+  for (auto& thread : m_threads) {
+    thread.join();
+  }
+}
+
+void ThreadPool::submit(Task&& task) {
+  const auto index = currentPool == this ? currentQueue : m_nextQueue++ % m_queues.size();
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_pendingTasks++;
+  }
+  {
+    auto& queue = *m_queues[index];
+    std::unique_lock<std::mutex> lock(queue.mutex);
+    queue.tasks.push_back(std::move(task));
+    queue.maxDepth = std::max<uint32_t>(queue.maxDepth, queue.tasks.size());
+  }
+  m_cv.notify_one();
+}
+
+uint32_t ThreadPool::threadsCount() const { return m_threads.size(); }
+
+std::vector<ThreadPool::QueueStatistics> ThreadPool::statistics() const {
+  std::vector<QueueStatistics> statistics;
+  for (const auto& queue : m_queues) {
+    std::unique_lock<std::mutex> lock(queue->mutex);
+    statistics.push_back({static_cast<uint32_t>(queue->tasks.size()), queue->maxDepth, queue->executed, queue->stolen});
+  }
+  return statistics;
+}
+
+void ThreadPool::run(uint32_t index) {
+  Logger::info(m_name.c_str(), "start thread id: {}", getThreadId());
+  setThreadParams("dsp_pool", PRIORITY::MEDIUM);
+  currentPool = this;
+  currentQueue = index;
+  while (true) {
+    auto task = pop(index);
+    if (task) {
+      try {
+        (*task)();
+      } catch (const std::exception& exception) {
+        Logger::error(m_name.c_str(), "task exception: {}", exception.what());
+      }
+      logStatistics();
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_cv.wait(lock, [this]() { return !m_isRunning || 0 < m_pendingTasks; });
+    if (!m_isRunning && m_pendingTasks == 0) {
+      break;
+    }
+  }
+  Logger::info(m_name.c_str(), "stop thread id: {}", getThreadId());
+}
+
+std::optional<ThreadPool::Task> ThreadPool::pop(uint32_t index) {
+  auto& own = *m_queues[index];
+  {
+    std::unique_lock<std::mutex> lock(own.mutex);
+    if (!own.tasks.empty()) {
+      std::optional<Task> task(std::move(own.tasks.front()));
+      own.tasks.pop_front();
+      m_pendingTasks--;
+      own.executed++;
+      return task;
+    }
+  }
+  for (uint32_t i = 1; i < m_queues.size(); ++i) {
+    auto& queue = *m_queues[(index + i) % m_queues.size()];
+    std::unique_lock<std::mutex> lock(queue.mutex);
+    if (!queue.tasks.empty()) {
+      std::optional<Task> task(std::move(queue.tasks.back()));
+      queue.tasks.pop_back();
+      m_pendingTasks--;
+      own.executed++;
+      own.stolen++;
+      return task;
+    }
+  }
+  return std::nullopt;
+}
+
+void ThreadPool::logStatistics() {
+  std::unique_lock<std::mutex> lock(m_logMutex, std::try_to_lock);
+  const auto now = std::chrono::steady_clock::now();
+  if (!lock.owns_lock() || now - m_lastLog < PRINT_STATISTICS_INTERVAL) {
+    return;
+  }
+  for (uint32_t i = 0; i < m_queues.size(); ++i) {
+    auto& queue = *m_queues[i];
+    std::unique_lock<std::mutex> queueLock(queue.mutex);
+    Logger::info(m_name.c_str(), "queue {}, depth: {}, max depth: {}, executed: {}, stolen: {}", i, queue.tasks.size(), queue.maxDepth, queue.executed.load(), queue.stolen.load());
+    queue.maxDepth = queue.tasks.size();
+  }
+  m_lastLog = now;
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Fixed set of threads shared by all scanners, each thread with its own task queue. A thread takes the oldest task
+// of its own queue and, when it is empty, steals the newest task of another queue. Tasks submitted from a pool thread
+// go to its own queue, other tasks are spread round robin. Tasks must not block waiting for other tasks.
+class ThreadPool {
+ public:
+  using Task = std::function<void()>;
+
+  struct QueueStatistics {
+    uint32_t depth;
+    uint32_t maxDepth;
+    uint64_t executed;
+    uint64_t stolen;
+  };
+
+  ThreadPool(const std::string& name, uint32_t threadsCount);
+  ~ThreadPool();
+
+  void submit(Task&& task);
+  uint32_t threadsCount() const;
+  std::vector<QueueStatistics> statistics() const;
+
+ private:
+  struct Queue {
+    mutable std::mutex mutex;
+    std::deque<Task> tasks;
+    uint32_t maxDepth = 0;
+    std::atomic_uint64_t executed = 0;
+    std::atomic_uint64_t stolen = 0;
+  };
+
+  void run(uint32_t index);
+  std::optional<Task> pop(uint32_t index);
+  void logStatistics();
+
+  const std::string m_name;
+  std::vector<std::unique_ptr<Queue>> m_queues;
+  std::atomic_uint32_t m_nextQueue;
+  std::atomic_uint32_t m_pendingTasks;
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  bool m_isRunning;
+  std::mutex m_logMutex;
+  std::chrono::steady_clock::time_point m_lastLog;
+  std::vector<std::thread> m_threads;
+};
@@ -0,0 +1,35 @@
+#include "timing_counters.h"
+
+#include <logger.h>
+
+constexpr auto PRINT_TIMING_INTERVAL = std::chrono::seconds(10);
+
+static float toMilliseconds(std::chrono::nanoseconds time) { return std::chrono::duration_cast<std::chrono::duration<float, std::milli>>(time).count(); }
+
+TimingCounters::TimingCounters(const std::string& name) : m_name(name), m_lastLog(std::chrono::steady_clock::now()) {}
+
+void TimingCounters::add(const char* operation, bool isControl, std::chrono::nanoseconds time) {
+  auto& counter = m_counters.try_emplace(operation, Counter{isControl, 0, std::chrono::nanoseconds(0)}).first->second;
+  counter.count++;
+  counter.time += time;
+
+  const auto now = std::chrono::steady_clock::now();
+  if (PRINT_TIMING_INTERVAL <= now - m_lastLog) {
+    std::chrono::nanoseconds controlTime(0);
+    std::chrono::nanoseconds transferTime(0);
+    for (const auto& [name, operationCounter] : m_counters) {
+      Logger::info(m_name.c_str(), "{}: {} x {:.2f} ms", name, operationCounter.count, toMilliseconds(operationCounter.time) / operationCounter.count);
+      (operationCounter.isControl ? controlTime : transferTime) += operationCounter.time;
+    }
+    const auto elapsed = now - m_lastLog;
+    Logger::info(
+        m_name.c_str(),
+        "control: {:.0f} ms ({:.1f}%), transfer: {:.0f} ms ({:.1f}%)",
+        toMilliseconds(controlTime),
+        100.0f * toMilliseconds(controlTime) / toMilliseconds(elapsed),
+        toMilliseconds(transferTime),
+        100.0f * toMilliseconds(transferTime) / toMilliseconds(elapsed));
+    m_counters.clear();
+    m_lastLog = now;
+  }
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <type_traits>
+
+// Accumulates count and total time of named device operations, split into control and sample transfers,
+// and periodically logs where the time goes.
+class TimingCounters {
+ public:
+  TimingCounters(const std::string& name);
+
+  template <typename F>
+  auto control(const char* operation, F&& f) {
+    return measure(operation, true, f);
+  }
+
+  template <typename F>
+  auto transfer(const char* operation, F&& f) {
+    return measure(operation, false, f);
+  }
+
+ private:
+  struct Counter {
+    bool isControl;
+    uint64_t count;
+    std::chrono::nanoseconds time;
+  };
+
+  template <typename F>
+  auto measure(const char* operation, bool isControl, F& f) {
+    const auto start = std::chrono::steady_clock::now();
+    if constexpr (std::is_void_v<decltype(f())>) {
+      f();
+      add(operation, isControl, std::chrono::steady_clock::now() - start);
+    } else {
+      auto result = f();
+      add(operation, isControl, std::chrono::steady_clock::now() - start);
+      return result;
+    }
+  }
+
+  void add(const char* operation, bool isControl, std::chrono::nanoseconds time);
+
+  const std::string m_name;
+  std::map<std::string, Counter> m_counters;
+  std::chrono::steady_clock::time_point m_lastLog;
+};
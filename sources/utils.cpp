@@ -3,6 +3,7 @@
 #include <liquid/liquid.h>
 #include <logger.h>
 #include <math.h>
+#include <simd/convert.h>
 #include <string.h>
 #include <sys/resource.h>
 #include <sys/time.h>
@@ -52,46 +53,10 @@ uint32_t getSamplesCount(const Frequency &sampleRate, const std::chrono::millise
   }
 }
 
-void toComplex(const uint8_t *rawBuffer, std::complex<float> *buffer, uint32_t samplesCount) {
-  static std::array<float, 256> cache;
-  static bool cacheInitialized = false;
-  if (!cacheInitialized) {
-    cacheInitialized = true;
-    for (int i = 0; i < 256; ++i) {
-      cache[i] = (static_cast<float>(i) - 127.5f) / 127.5f;
-    }
-  }
-  float *p1 = reinterpret_cast<float *>(buffer);
-  uint8_t *p2 = const_cast<uint8_t *>(rawBuffer);
-  for (uint32_t i = 0; i < samplesCount; ++i) {
-    *p1 = cache[*p2];
-    ++p1;
-    ++p2;
-  }
-}
+void toComplex(const uint8_t *rawBuffer, std::complex<float> *buffer, uint32_t samplesCount, SampleFormat format) { convert(rawBuffer, buffer, samplesCount, format); }
 
 std::chrono::milliseconds time() { return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()); }
 
-std::vector<std::complex<float>> getShiftData(int32_t frequencyOffset, Frequency sampleRate, uint32_t samplesCount) {
-  const float floatFreqOffset{static_cast<float>(-frequencyOffset)};
-  const float floatSampleRate{static_cast<float>(sampleRate)};
-  const float floatPI{static_cast<float>(M_PI)};
-  const float imaginaryUnit{-1.0f};
-
-  const auto f = std::complex<float>(0.0f, imaginaryUnit) * 2.0f * floatPI * (floatFreqOffset / floatSampleRate);
-  std::vector<std::complex<float>> data(samplesCount);
-  for (uint32_t i = 0; i < samplesCount; ++i) {
-    data[i] = std::exp(f * static_cast<float>(i));
-  }
-  return data;
-}
-
-void shift(std::complex<float> *samples, const std::vector<std::complex<float>> &factors, uint32_t samplesCount) {
-  for (uint32_t i = 0; i < samplesCount; ++i) {
-    samples[i] *= factors[i];
-  }
-}
-
 liquid_float_complex *toLiquidComplex(std::complex<float> *ptr) { return reinterpret_cast<liquid_float_complex *>(ptr); }
 
 std::vector<FrequencyRange> fitFrequencyRange(const UserDefinedFrequencyRange &userRange) {
@@ -0,0 +1,62 @@
+#include <bounded_queue.h>
+#include <gtest/gtest.h>
+
+#include <thread>
+
+TEST(BoundedQueueTest, Order) {
+  BoundedQueue<int> queue(3);
+  EXPECT_TRUE(queue.push(1));
+  EXPECT_TRUE(queue.push(2));
+  EXPECT_EQ(queue.size(), 2);
+  EXPECT_EQ(queue.pop(), 1);
+  EXPECT_EQ(queue.pop(), 2);
+  EXPECT_EQ(queue.size(), 0);
+}
+
+TEST(BoundedQueueTest, Blocking) {
+  constexpr auto COUNT = 10000;
+  BoundedQueue<int> queue(2);
+  std::thread producer([&queue]() {
+    for (int i = 0; i < COUNT; ++i) {
+      EXPECT_TRUE(queue.push(int(i)));
+      EXPECT_LE(queue.size(), 2);
+    }
+  });
+  for (int i = 0; i < COUNT; ++i) {
+    EXPECT_EQ(queue.pop(), i);
+  }
+  producer.join();
+}
+
+TEST(BoundedQueueTest, Close) {
+  BoundedQueue<int> queue(1);
+  EXPECT_TRUE(queue.push(1));
+  std::thread producer([&queue]() { EXPECT_FALSE(queue.push(2)); });
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  queue.close();
+  producer.join();
+  EXPECT_EQ(queue.pop(), 1);
+  EXPECT_EQ(queue.pop(), std::nullopt);
+  EXPECT_FALSE(queue.push(3));
+}
+
+TEST(BoundedQueueTest, Clear) {
+  BoundedQueue<int> queue(1);
+  EXPECT_TRUE(queue.push(1));
+  std::thread producer([&queue]() { EXPECT_TRUE(queue.push(2)); });
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  queue.clear();
+  producer.join();
+  EXPECT_EQ(queue.pop(), 2);
+}
+
+TEST(BoundedQueueTest, TryPush) {
+  BoundedQueue<int> queue(1);
+  EXPECT_TRUE(queue.tryPush(1));
+  EXPECT_FALSE(queue.tryPush(2));
+  EXPECT_EQ(queue.pop(), 1);
+  EXPECT_TRUE(queue.tryPush(3));
+  queue.close();
+  EXPECT_FALSE(queue.tryPush(4));
+  EXPECT_EQ(queue.pop(), 3);
+}
@@ -0,0 +1,57 @@
+#include <buffer_pool.h>
+#include <gtest/gtest.h>
+
+TEST(BufferPoolTest, Recycle) {
+  BufferPool<uint8_t> pool("BufferPool", 2);
+  EXPECT_EQ(pool.buffersCount(), 2);
+  EXPECT_EQ(pool.freeBuffersCount(), 2);
+
+  uint8_t* data = nullptr;
+  {
+    auto buffer = pool.acquire(100);
+    EXPECT_EQ(buffer.size(), 100);
+    EXPECT_EQ(pool.freeBuffersCount(), 1);
+    data = buffer.data();
+  }
+  EXPECT_EQ(pool.freeBuffersCount(), 2);
+
+  for (int i = 0; i < 10; ++i) {
+    auto buffer = pool.acquire(50);
+    EXPECT_EQ(buffer.size(), 50);
+    EXPECT_EQ(buffer.data(), data);
+  }
+  EXPECT_EQ(pool.buffersCount(), 2);
+}
+
+TEST(BufferPoolTest, References) {
+  BufferPool<float> pool("BufferPool", 1);
+
+  auto buffer = pool.acquire(10);
+  auto copy = buffer;
+  EXPECT_EQ(copy.data(), buffer.data());
+  EXPECT_EQ(pool.freeBuffersCount(), 0);
+
+  buffer.reset();
+  EXPECT_FALSE(buffer);
+  EXPECT_EQ(pool.freeBuffersCount(), 0);
+
+  auto moved = std::move(copy);
+  EXPECT_FALSE(copy);
+  EXPECT_EQ(pool.freeBuffersCount(), 0);
+
+  moved = {};
+  EXPECT_EQ(pool.freeBuffersCount(), 1);
+}
+
+TEST(BufferPoolTest, Exhausted) {
+  BufferPool<uint8_t> pool("BufferPool", 1);
+
+  auto first = pool.acquire(10);
+  auto second = pool.acquire(10);
+  EXPECT_NE(first.data(), second.data());
+  EXPECT_EQ(pool.buffersCount(), 2);
+
+  first.reset();
+  second.reset();
+  EXPECT_EQ(pool.freeBuffersCount(), 2);
+}
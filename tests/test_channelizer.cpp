@@ -0,0 +1,91 @@
+#include <algorithms/polyphase_channelizer.h>
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+constexpr Frequency SAMPLE_RATE = 2560000;
+constexpr uint32_t DECIMATION = 40;
+constexpr uint32_t CHANNELIZER_DECIMATION = 10;
+constexpr uint32_t SAMPLES = 40000;
+constexpr uint32_t SETTLE_SAMPLES = 100;
+const std::vector<std::string> CHANNELIZERS = {"polyphase", "overlap_save"};
+
+Config channelizerConfig(const std::string& channelizer) { return Config("", R"({"recording": {"channelizer": ")" + channelizer + R"("}})"); }
+
+std::vector<std::complex<float>> tone(int32_t frequency) {
+  std::vector<std::complex<float>> samples(SAMPLES);
+  for (uint32_t i = 0; i < SAMPLES; ++i) {
+    samples[i] = std::complex<float>(std::polar(1.0, 2.0 * M_PI * frequency * i / SAMPLE_RATE));
+  }
+  return samples;
+}
+
+std::vector<std::complex<float>> channelize(Channelizer& channelizer, const std::vector<std::complex<float>>& input, uint32_t channel, uint32_t chunk) {
+  std::vector<std::complex<float>> output;
+  for (uint32_t offset = 0; offset < input.size(); offset += chunk) {
+    const auto size = std::min<uint32_t>(chunk, input.size() - offset);
+    std::vector<std::complex<float>> buffer(channelizer.outputSize(size));
+    channelizer.process(input.data() + offset, size, {channel}, {buffer.data()});
+    output.insert(output.end(), buffer.begin(), buffer.end());
+  }
+  return output;
+}
+
+TEST(ChannelizerTest, Decimation) {
+  EXPECT_EQ(channelizerDecimation(32), 8);
+  EXPECT_EQ(channelizerDecimation(40), 10);
+  EXPECT_EQ(channelizerDecimation(37), 37);
+  EXPECT_EQ(channelizerDecimation(2), 2);
+  const Config config("", "{}");
+  PolyphaseChannelizer channelizer(config, SAMPLE_RATE, DECIMATION);
+  EXPECT_EQ(channelizer.outputSampleRate(), SAMPLE_RATE / CHANNELIZER_DECIMATION);
+  EXPECT_EQ(channelizer.workerDecimation(), DECIMATION / CHANNELIZER_DECIMATION);
+  EXPECT_EQ(channelizer.outputSize(SAMPLES), SAMPLES / CHANNELIZER_DECIMATION);
+}
+
+TEST(ChannelizerTest, ToneInChannel) {
+  for (const auto& name : CHANNELIZERS) {
+    const auto config = channelizerConfig(name);
+    for (const auto frequency : {0, 300000, -420000, 303000}) {
+      auto channelizer = createChannelizer(config, SAMPLE_RATE, DECIMATION);
+      const auto channel = channelizer->channel(frequency);
+      EXPECT_LE(std::abs(channel.residual), static_cast<int32_t>(channelizer->outputSampleRate() / 4));
+      EXPECT_EQ(channelizer->outputSampleRate() / channelizer->workerDecimation(), SAMPLE_RATE / DECIMATION);
+      const auto output = channelize(*channelizer, tone(frequency), channel.index, SAMPLES);
+      ASSERT_LT(2 * SETTLE_SAMPLES, output.size()) << name;
+      const auto step = std::polar(1.0f, static_cast<float>(2.0 * M_PI * channel.residual / channelizer->outputSampleRate()));
+      for (uint32_t i = SETTLE_SAMPLES; i + 1 < output.size(); ++i) {
+        ASSERT_NEAR(std::abs(output[i]), 1.0f, 0.01f) << name << ", " << frequency;
+        ASSERT_NEAR(std::abs(output[i + 1] - output[i] * step), 0.0f, 1e-3f) << name << ", " << frequency;
+      }
+    }
+  }
+}
+
+TEST(ChannelizerTest, OtherChannelsRejected) {
+  for (const auto& name : CHANNELIZERS) {
+    auto channelizer = createChannelizer(channelizerConfig(name), SAMPLE_RATE, DECIMATION);
+    const auto output = channelize(*channelizer, tone(300000), channelizer->channel(900000).index, SAMPLES);
+    for (uint32_t i = SETTLE_SAMPLES; i < output.size(); ++i) {
+      ASSERT_LT(std::abs(output[i]), 1e-3f) << name;
+    }
+  }
+}
+
+TEST(ChannelizerTest, ChunksMatchSingleCall) {
+  for (const auto& name : CHANNELIZERS) {
+    const auto config = channelizerConfig(name);
+    const auto input = tone(120000);
+    auto whole = createChannelizer(config, SAMPLE_RATE, DECIMATION);
+    auto chunked = createChannelizer(config, SAMPLE_RATE, DECIMATION);
+    const auto channel = whole->channel(120000).index;
+    const auto expected = channelize(*whole, input, channel, SAMPLES);
+    const auto output = channelize(*chunked, input, channel, 1237);
+    ASSERT_EQ(output.size(), expected.size()) << name;
+    for (uint32_t i = 0; i < output.size(); ++i) {
+      ASSERT_NEAR(std::abs(output[i] - expected[i]), 0.0f, 1e-4f) << name;
+    }
+  }
+}
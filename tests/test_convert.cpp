@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+#include <simd/convert.h>
+
+#include <vector>
+
+using Function = void (*)(const uint8_t*, std::complex<float>*, uint32_t, SampleFormat);
+
+std::vector<Function> supportedFunctions() {
+  std::vector<Function> functions{convertScalar};
+#ifdef SIMD_X86
+  if (simdLevel() >= SimdLevel::SSE2) functions.push_back(convertSse2);
+  if (simdLevel() >= SimdLevel::AVX2) functions.push_back(convertAvx2);
+  if (simdLevel() >= SimdLevel::AVX512) functions.push_back(convertAvx512);
+#endif
+  functions.push_back(convert);
+  return functions;
+}
+
+TEST(ConvertTest, Formula) {
+  std::vector<uint8_t> input(256);
+  for (uint32_t i = 0; i < input.size(); ++i) {
+    input[i] = i;
+  }
+  std::vector<std::complex<float>> output(input.size() / 2);
+  convert(input.data(), output.data(), input.size(), SampleFormat::CU8);
+  for (uint32_t i = 0; i < output.size(); ++i) {
+    EXPECT_NEAR(output[i].real(), (2 * i - 127.5f) / 127.5f, 1e-6);
+    EXPECT_NEAR(output[i].imag(), (2 * i + 1 - 127.5f) / 127.5f, 1e-6);
+  }
+}
+
+TEST(ConvertTest, SignedMatchesUnsigned) {
+  std::vector<uint8_t> input(256);
+  std::vector<uint8_t> flipped(256);
+  for (uint32_t i = 0; i < input.size(); ++i) {
+    input[i] = i;
+    flipped[i] = i ^ 0b10000000;
+  }
+  std::vector<std::complex<float>> unsignedOutput(input.size() / 2);
+  std::vector<std::complex<float>> signedOutput(input.size() / 2);
+  convert(input.data(), unsignedOutput.data(), input.size(), SampleFormat::CU8);
+  convert(flipped.data(), signedOutput.data(), flipped.size(), SampleFormat::CS8);
+  EXPECT_EQ(unsignedOutput, signedOutput);
+}
+
+TEST(ConvertTest, KernelsMatchScalar) {
+  for (const auto size : {0, 2, 14, 30, 62, 64, 126, 1000, 16386}) {
+    std::vector<uint8_t> input(size);
+    for (int i = 0; i < size; ++i) {
+      input[i] = (i * 37 + 11) % 256;
+    }
+    for (const auto format : {SampleFormat::CU8, SampleFormat::CS8}) {
+      std::vector<std::complex<float>> expected(size / 2);
+      convertScalar(input.data(), expected.data(), size, format);
+      for (const auto function : supportedFunctions()) {
+        std::vector<std::complex<float>> output(size / 2);
+        function(input.data(), output.data(), size, format);
+        for (int i = 0; i < size / 2; ++i) {
+          ASSERT_NEAR(output[i].real(), expected[i].real(), 1e-6);
+          ASSERT_NEAR(output[i].imag(), expected[i].imag(), 1e-6);
+        }
+      }
+    }
+  }
+}
+
+TEST(ConvertTest, ShiftWindowMatchesThreePasses) {
+  for (const auto samples : {0, 3, 4, 7, 64, 1025}) {
+    std::vector<uint8_t> input(2 * samples);
+    std::vector<std::complex<float>> shift(samples);
+    std::vector<float> window(samples);
+    for (int i = 0; i < samples; ++i) {
+      input[2 * i] = (i * 37 + 11) % 256;
+      input[2 * i + 1] = (i * 91 + 5) % 256;
+      shift[i] = std::polar(1.0f, 0.1f * i);
+      window[i] = 0.5f + 0.5f * std::cos(0.01f * i);
+    }
+    for (const auto format : {SampleFormat::CU8, SampleFormat::CS8}) {
+      for (const auto factors : {static_cast<const std::complex<float>*>(nullptr), static_cast<const std::complex<float>*>(shift.data())}) {
+        std::vector<std::complex<float>> expected(samples);
+        convertScalar(input.data(), expected.data(), input.size(), format);
+        for (int i = 0; i < samples; ++i) {
+          expected[i] = (factors ? expected[i] * factors[i] : expected[i]) * window[i];
+        }
+        std::vector<std::complex<float>> output(samples);
+        convertShiftWindow(input.data(), factors, window.data(), output.data(), samples, format);
+        for (int i = 0; i < samples; ++i) {
+          ASSERT_NEAR(output[i].real(), expected[i].real(), 1e-5);
+          ASSERT_NEAR(output[i].imag(), expected[i].imag(), 1e-5);
+        }
+      }
+    }
+  }
+}
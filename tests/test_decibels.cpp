@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+#include <simd/decibels.h>
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+constexpr auto MAX_ERROR = 0.01f;
+
+std::vector<float> powers() {
+  std::mt19937 generator(0);
+  std::uniform_real_distribution<float> distribution(-30.0f, 30.0f);
+  std::vector<float> values;
+  for (int i = 0; i < 100000; ++i) {
+    values.push_back(std::pow(10.0f, distribution(generator)));
+  }
+  for (int i = -10; i <= 10; ++i) {
+    values.push_back(std::ldexp(1.0f, i));
+  }
+  return values;
+}
+
+void expectErrorBound(void (*function)(const float*, float*, uint32_t, float), float scale) {
+  const auto input = powers();
+  std::vector<float> output(input.size());
+  function(input.data(), output.data(), input.size(), scale);
+  for (uint32_t i = 0; i < input.size(); ++i) {
+    const auto expected = 10.0 * std::log10(static_cast<double>(input[i]) * scale);
+    ASSERT_NEAR(output[i], expected, MAX_ERROR) << input[i];
+  }
+}
+
+TEST(DecibelsTest, ScalarErrorBound) {
+  expectErrorBound(toDecibelsScalar, 1.0f);
+  expectErrorBound(toDecibelsScalar, 1.0f / 3e9f);
+}
+
+TEST(DecibelsTest, DispatchedErrorBound) {
+  expectErrorBound(toDecibels, 1.0f);
+  expectErrorBound(toDecibels, 1.0f / 3e9f);
+}
+
+TEST(DecibelsTest, KernelsMatchScalar) {
+  const auto input = powers();
+  for (const auto size : {0, 1, 7, 8, 9, 1023}) {
+    std::vector<float> expected(size);
+    toDecibelsScalar(input.data(), expected.data(), size, 0.5f);
+    std::vector<float> output(input.begin(), input.begin() + size);
+    toDecibels(output.data(), output.data(), size, 0.5f);
+    for (int i = 0; i < size; ++i) {
+      ASSERT_NEAR(output[i], expected[i], 1e-4f);
+    }
+  }
+}
+
+TEST(DecibelsTest, ZeroIsFinite) {
+  const std::vector<float> input{0.0f, -1.0f, 1e-40f};
+  std::vector<float> output(input.size());
+  toDecibels(input.data(), output.data(), input.size(), 1.0f);
+  for (const auto value : output) {
+    EXPECT_TRUE(std::isfinite(value));
+    EXPECT_NEAR(value, 10.0f * std::log10(std::numeric_limits<float>::min()), MAX_ERROR);
+  }
+}
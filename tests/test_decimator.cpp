@@ -0,0 +1,119 @@
+#include <algorithms/decimator.h>
+#include <gtest/gtest.h>
+#include <simd/fir.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+constexpr uint32_t DECIMATOR_OUTPUT_SAMPLES = 1000;
+constexpr uint32_t DECIMATOR_SETTLE_SAMPLES = 100;
+constexpr auto DECIMATOR_OUTPUT_PASSBAND = 0.4;
+constexpr auto MAX_RIPPLE_DB = 0.2;
+constexpr auto MIN_ATTENUATION_DB = 58.0;
+const std::vector<uint32_t> RATES = {2, 3, 4, 5, 8, 12, 24, 40};
+
+// frequency relative to the input rate
+std::vector<std::complex<float>> decimatorTone(double frequency, uint32_t size) {
+  std::vector<std::complex<float>> samples(size);
+  for (uint32_t i = 0; i < size; ++i) {
+    samples[i] = std::complex<float>(std::polar(1.0, 2.0 * M_PI * std::fmod(frequency * i, 1.0)));
+  }
+  return samples;
+}
+
+double decimatedGain(uint32_t rate, double frequency) {
+  Decimator decimator(rate);
+  const auto input = decimatorTone(frequency, DECIMATOR_OUTPUT_SAMPLES * rate);
+  std::vector<std::complex<float>> output(DECIMATOR_OUTPUT_SAMPLES);
+  decimator.decimate(input.data(), output.size(), output.data());
+  double maxAmplitude = 0.0;
+  for (uint32_t i = DECIMATOR_SETTLE_SAMPLES; i < output.size(); ++i) {
+    maxAmplitude = std::max(maxAmplitude, static_cast<double>(std::abs(output[i])));
+  }
+  return 20.0 * std::log10(maxAmplitude);
+}
+
+TEST(DecimatorTest, PassbandRipple) {
+  for (const auto rate : RATES) {
+    for (int i = -10; i <= 10; ++i) {
+      const auto frequency = DECIMATOR_OUTPUT_PASSBAND * i / 10 / rate;
+      EXPECT_NEAR(decimatedGain(rate, frequency), 0.0, MAX_RIPPLE_DB) << "rate: " << rate << ", frequency: " << frequency;
+    }
+  }
+}
+
+// tones which alias into the passband after decimation
+TEST(DecimatorTest, StopbandAttenuation) {
+  for (const auto rate : RATES) {
+    for (uint32_t image = 1; image < rate; ++image) {
+      for (int i = -4; i <= 4; ++i) {
+        const auto frequency = (image + DECIMATOR_OUTPUT_PASSBAND * i / 4) / rate;
+        EXPECT_LT(decimatedGain(rate, frequency), -MIN_ATTENUATION_DB) << "rate: " << rate << ", frequency: " << frequency;
+      }
+    }
+  }
+}
+
+TEST(DecimatorTest, ChunksMatchSingleCall) {
+  for (const auto rate : RATES) {
+    const auto input = decimatorTone(0.13 / rate, DECIMATOR_OUTPUT_SAMPLES * rate);
+    Decimator single(rate);
+    std::vector<std::complex<float>> expected(DECIMATOR_OUTPUT_SAMPLES);
+    single.decimate(input.data(), expected.size(), expected.data());
+
+    Decimator chunked(rate);
+    std::vector<std::complex<float>> output(DECIMATOR_OUTPUT_SAMPLES);
+    for (uint32_t offset = 0, chunk = 1; offset < output.size(); offset += chunk, chunk = chunk % 97 + 13) {
+      const auto size = std::min(chunk, DECIMATOR_OUTPUT_SAMPLES - offset);
+      chunked.decimate(input.data() + offset * rate, size, output.data() + offset);
+    }
+    for (uint32_t i = 0; i < output.size(); ++i) {
+      ASSERT_NEAR(std::abs(output[i] - expected[i]), 0.0f, 1e-5f) << "rate: " << rate << ", index: " << i;
+    }
+  }
+}
+
+TEST(DecimatorTest, ResetMatchesNewDecimator) {
+  for (const auto rate : RATES) {
+    const auto input = decimatorTone(0.13 / rate, DECIMATOR_OUTPUT_SAMPLES * rate);
+    Decimator fresh(rate);
+    std::vector<std::complex<float>> expected(DECIMATOR_OUTPUT_SAMPLES);
+    fresh.decimate(input.data(), expected.size(), expected.data());
+
+    Decimator reused(rate);
+    const auto previous = decimatorTone(0.07 / rate, 101 * rate);
+    std::vector<std::complex<float>> output(DECIMATOR_OUTPUT_SAMPLES);
+    reused.decimate(previous.data(), 101, output.data());
+    reused.reset();
+    reused.decimate(input.data(), output.size(), output.data());
+    for (uint32_t i = 0; i < output.size(); ++i) {
+      ASSERT_EQ(output[i], expected[i]) << "rate: " << rate << ", index: " << i;
+    }
+  }
+}
+
+TEST(DecimatorTest, KernelsMatchScalar) {
+  std::mt19937 generator(0);
+  std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+  std::vector<std::complex<float>> input(4096);
+  for (auto& sample : input) {
+    sample = {distribution(generator), distribution(generator)};
+  }
+  std::vector<float> taps(67);
+  for (auto& tap : taps) {
+    tap = distribution(generator);
+  }
+  for (uint32_t tapsSize = 1; tapsSize <= taps.size(); tapsSize += 3) {
+    for (const auto stride : {1u, 2u, 5u}) {
+      const auto size = (input.size() - tapsSize) / stride + 1;
+      std::vector<std::complex<float>> expected(size);
+      std::vector<std::complex<float>> output(size);
+      firScalar(input.data(), taps.data(), tapsSize, stride, expected.data(), size);
+      fir(input.data(), taps.data(), tapsSize, stride, output.data(), size);
+      for (uint32_t i = 0; i < size; ++i) {
+        ASSERT_NEAR(std::abs(output[i] - expected[i]), 0.0f, 1e-4f) << "taps: " << tapsSize << ", stride: " << stride;
+      }
+    }
+  }
+}
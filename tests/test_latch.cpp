@@ -0,0 +1,30 @@
+#include <gtest/gtest.h>
+#include <latch.h>
+#include <thread_pool.h>
+
+#include <atomic>
+
+TEST(LatchTest, WaitForAllTasks) {
+  constexpr auto TASKS = 8;
+  ThreadPool pool("ThreadPool", 4);
+  Latch latch(0);
+  std::atomic_uint32_t counter(0);
+  for (int round = 0; round < 100; ++round) {
+    latch.reset(TASKS);
+    for (int i = 0; i < TASKS; ++i) {
+      pool.submit([&latch, &counter]() {
+        counter++;
+        latch.countDown();
+      });
+    }
+    latch.wait();
+    EXPECT_EQ(counter, (round + 1) * TASKS);
+  }
+}
+
+TEST(LatchTest, ZeroCount) {
+  Latch latch(0);
+  latch.wait();
+  latch.countDown();
+  latch.wait();
+}
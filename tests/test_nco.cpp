@@ -0,0 +1,52 @@
+#include <algorithms/nco.h>
+#include <gtest/gtest.h>
+#include <simd/rotate.h>
+
+#include <cmath>
+#include <vector>
+
+constexpr int32_t FREQUENCY = 12345;
+constexpr Frequency SAMPLE_RATE = 2048000;
+
+std::complex<float> expected(int32_t frequency, uint32_t index) { return std::complex<float>(std::polar(1.0, 2.0 * M_PI * frequency * index / SAMPLE_RATE)); }
+
+TEST(NcoTest, PhaseContinuousAcrossChunks) {
+  Nco nco(FREQUENCY, SAMPLE_RATE);
+  std::vector<std::complex<float>> samples(100000, 1.0f);
+  nco.mix(samples.data(), 3001);
+  nco.mix(samples.data() + 3001, samples.size() - 3001);
+  for (uint32_t i = 0; i < samples.size(); ++i) {
+    ASSERT_NEAR(samples[i].real(), expected(FREQUENCY, i).real(), 1e-4);
+    ASSERT_NEAR(samples[i].imag(), expected(FREQUENCY, i).imag(), 1e-4);
+  }
+}
+
+TEST(NcoTest, Skip) {
+  Nco nco(-FREQUENCY, SAMPLE_RATE);
+  std::vector<std::complex<float>> samples(10, 1.0f);
+  nco.skip(1000000);
+  nco.mix(samples.data(), samples.size());
+  for (uint32_t i = 0; i < samples.size(); ++i) {
+    EXPECT_NEAR(samples[i].real(), expected(-FREQUENCY, 1000000 + i).real(), 1e-4);
+    EXPECT_NEAR(samples[i].imag(), expected(-FREQUENCY, 1000000 + i).imag(), 1e-4);
+  }
+}
+
+TEST(NcoTest, RotateKernelsMatchScalar) {
+  const auto step = std::complex<float>(std::polar(1.0, 0.01));
+  const auto phase = std::complex<float>(std::polar(1.0, 0.5));
+  for (const auto size : {0, 1, 3, 4, 5, 17, 1024}) {
+    std::vector<std::complex<float>> input(size);
+    for (int i = 0; i < size; ++i) {
+      input[i] = {0.01f * i, -0.02f * i};
+    }
+    std::vector<std::complex<float>> expectedOutput(size);
+    const auto expectedPhase = rotateScalar(input.data(), expectedOutput.data(), size, phase, step);
+    std::vector<std::complex<float>> output(size);
+    const auto outputPhase = rotate(input.data(), output.data(), size, phase, step);
+    EXPECT_NEAR(std::abs(outputPhase - expectedPhase), 0.0f, 1e-4);
+    for (int i = 0; i < size; ++i) {
+      ASSERT_LE(std::abs(output[i] - expectedOutput[i]), 1e-5 * (1.0f + std::abs(expectedOutput[i])));
+    }
+  }
+}
@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+#include <pipeline_stage.h>
+
+#include <atomic>
+#include <vector>
+
+TEST(PipelineStageTest, OrderAndFlush) {
+  constexpr auto COUNT = 1000;
+  std::vector<int> values;
+  PipelineStage<int> stage("TestStage", COUNT, [&values](int&& value) { values.push_back(value); });
+  for (int i = 0; i < COUNT; ++i) {
+    EXPECT_TRUE(stage.push(int(i)));
+  }
+  stage.flush();
+  ASSERT_EQ(values.size(), COUNT);
+  for (int i = 0; i < COUNT; ++i) {
+    EXPECT_EQ(values[i], i);
+  }
+  const auto statistics = stage.statistics();
+  EXPECT_EQ(statistics.size, 0);
+  EXPECT_EQ(statistics.processed, COUNT);
+  EXPECT_EQ(statistics.dropped, 0);
+}
+
+TEST(PipelineStageTest, DropWhenFull) {
+  std::atomic_bool isBlocked(true);
+  std::atomic_uint32_t processed(0);
+  PipelineStage<int> stage("TestStage", 2, [&isBlocked, &processed](int&&) {
+    while (isBlocked) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    processed++;
+  });
+  EXPECT_TRUE(stage.tryPush(1));
+  while (stage.statistics().size != 0) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  EXPECT_TRUE(stage.tryPush(2));
+  EXPECT_TRUE(stage.tryPush(3));
+  EXPECT_FALSE(stage.tryPush(4));
+  auto statistics = stage.statistics();
+  EXPECT_EQ(statistics.size, 2);
+  EXPECT_EQ(statistics.maxSize, 2);
+  EXPECT_EQ(statistics.dropped, 1);
+  isBlocked = false;
+  stage.flush();
+  EXPECT_EQ(processed, 3);
+  statistics = stage.statistics();
+  EXPECT_EQ(statistics.processed, 3);
+  EXPECT_EQ(statistics.dropped, 1);
+}
+
+TEST(PipelineStageTest, DropOnlyAtEntry) {
+  constexpr auto COUNT = 200;
+  std::vector<int> values;
+  PipelineStage<int> last("LastStage", 1, [&values](int&& value) {
+    std::this_thread::sleep_for(std::chrono::microseconds(200));
+    values.push_back(value);
+  });
+  PipelineStage<int> first("FirstStage", 1, [&last](int&& value) { last.push(std::move(value)); });
+  std::vector<int> accepted;
+  for (int i = 0; i < COUNT; ++i) {
+    if (first.tryPush(int(i))) {
+      accepted.push_back(i);
+    }
+  }
+  first.flush();
+  last.flush();
+  EXPECT_LT(accepted.size(), COUNT);
+  EXPECT_EQ(values, accepted);
+  EXPECT_EQ(first.statistics().dropped, COUNT - accepted.size());
+  EXPECT_EQ(last.statistics().dropped, 0);
+}
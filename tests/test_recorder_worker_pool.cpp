@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+#include <radio/recorder_worker_pool.h>
+
+constexpr Frequency WORKER_POOL_SAMPLE_RATE = 512000;
+const FrequencyRange WORKER_POOL_FIRST{100000000, 100016000, 16000, 0};
+const FrequencyRange WORKER_POOL_SECOND{100100000, 100116000, 16000, 0};
+
+class RecorderWorkerPoolTest : public ::testing::Test {
+ protected:
+  const Config m_config{"", R"({"recording": {"max_concurrent": 2}})"};
+  ThreadPool m_pool{"ThreadPool", 1};
+  Mqtt m_mqtt{m_config};
+  DataController m_dataController{m_config, m_mqtt, "test"};
+};
+
+TEST_F(RecorderWorkerPoolTest, ReuseCompatibleWorkers) {
+  RecorderWorkerPool pool(m_config, m_pool, m_dataController);
+  const ResamplingRatio resampling{1, 1};
+  auto first = pool.acquire(WORKER_POOL_FIRST, WORKER_POOL_SAMPLE_RATE, 1000, 8, resampling);
+  auto second = pool.acquire(WORKER_POOL_SECOND, WORKER_POOL_SAMPLE_RATE, -1000, 8, resampling);
+  EXPECT_EQ(pool.createdWorkers(), 2);
+  EXPECT_EQ(pool.reusedWorkers(), 0);
+
+  const auto released = first.get();
+  pool.release(std::move(first));
+  EXPECT_EQ(pool.idleWorkers(), 1);
+  auto reused = pool.acquire(WORKER_POOL_SECOND, WORKER_POOL_SAMPLE_RATE, 2000, 8, resampling);
+  EXPECT_EQ(reused.get(), released);
+  EXPECT_EQ(pool.createdWorkers(), 2);
+  EXPECT_EQ(pool.reusedWorkers(), 1);
+  EXPECT_EQ(pool.idleWorkers(), 0);
+}
+
+TEST_F(RecorderWorkerPoolTest, SkipIncompatibleWorkers) {
+  RecorderWorkerPool pool(m_config, m_pool, m_dataController);
+  pool.release(pool.acquire(WORKER_POOL_FIRST, WORKER_POOL_SAMPLE_RATE, 0, 8, {1, 1}));
+  pool.acquire(WORKER_POOL_FIRST, WORKER_POOL_SAMPLE_RATE, 0, 4, {1, 1}).reset();
+  pool.acquire(WORKER_POOL_FIRST, 2 * WORKER_POOL_SAMPLE_RATE, 0, 8, {1, 1}).reset();
+  pool.acquire(WORKER_POOL_FIRST, WORKER_POOL_SAMPLE_RATE, 0, 8, {2, 3}).reset();
+  EXPECT_EQ(pool.createdWorkers(), 4);
+  EXPECT_EQ(pool.reusedWorkers(), 0);
+  EXPECT_EQ(pool.idleWorkers(), 1);
+}
+
+TEST_F(RecorderWorkerPoolTest, KeepAtMostMaxConcurrentIdleWorkers) {
+  RecorderWorkerPool pool(m_config, m_pool, m_dataController);
+  std::vector<std::unique_ptr<RecorderWorker>> workers;
+  for (int i = 0; i < 3; ++i) {
+    workers.push_back(pool.acquire(WORKER_POOL_FIRST, WORKER_POOL_SAMPLE_RATE, 0, 8, {1, 1}));
+  }
+  for (auto& worker : workers) {
+    pool.release(std::move(worker));
+  }
+  EXPECT_EQ(pool.idleWorkers(), 2);
+}
+
+TEST_F(RecorderWorkerPoolTest, ShareChannelizers) {
+  RecorderWorkerPool pool(m_config, m_pool, m_dataController);
+  const auto channelizer = pool.channelizer(2048000, 32);
+  EXPECT_EQ(channelizer->sampleRate(), 2048000);
+  EXPECT_EQ(pool.channelizer(2048000, 32), channelizer);
+  EXPECT_NE(pool.channelizer(2048000, 16), channelizer);
+  EXPECT_NE(pool.channelizer(1024000, 32), channelizer);
+}
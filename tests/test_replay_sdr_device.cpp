@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+#include <radio/replay_sdr_device.h>
+
+#include <filesystem>
+#include <fstream>
+
+constexpr Frequency FREQUENCY = 100000000;
+constexpr Frequency SAMPLE_RATE = 2048000;
+constexpr uint32_t SAMPLES_SIZE = 409600;
+const auto PATH = (std::filesystem::temp_directory_path() / "hackrfscanner_20240101_000000_100000000_2048000_fc.cs8").string();
+
+class ReplaySdrDeviceTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    std::ofstream file(PATH, std::ios::binary | std::ios::out | std::ios::trunc);
+    for (uint32_t i = 0; i < 2 * SAMPLES_SIZE; ++i) {
+      file.put(static_cast<char>(i % 256));
+    }
+  }
+
+  void TearDown() override { std::filesystem::remove(PATH); }
+
+  const FrequencyRange m_range{FREQUENCY - SAMPLE_RATE / 2, FREQUENCY + SAMPLE_RATE / 2, SAMPLE_RATE, 2048};
+  const Config m_config{"", R"({"devices": {"replay": {"path": ")" + PATH + R"(", "realtime": false}}})"};
+};
+
+TEST_F(ReplaySdrDeviceTest, ReadData) {
+  ReplaySdrDevice device(m_config, "replay");
+  EXPECT_EQ(ReplaySdrDevice::listDevices(m_config), std::vector<std::string>{"replay"});
+  EXPECT_EQ(device.format(), SampleFormat::CS8);
+
+  const auto first = device.readData(m_range);
+  EXPECT_EQ(first.size, SAMPLES_SIZE);
+  for (uint32_t i = 0; i < first.size; ++i) {
+    ASSERT_EQ(first.data[i], i % 256);
+  }
+  const auto second = device.readData(m_range);
+  EXPECT_EQ(second.size, SAMPLES_SIZE);
+  EXPECT_EQ((second.time - first.time).count(), 100);
+  EXPECT_THROW(device.readData(m_range), std::runtime_error);
+}
+
+TEST_F(ReplaySdrDeviceTest, Stream) {
+  ReplaySdrDevice device(m_config, "replay");
+  device.startStream(m_range);
+  for (int i = 0; i < 2; ++i) {
+    device.waitForData();
+    const auto samples = device.getStreamData();
+    EXPECT_EQ(samples.size, SAMPLES_SIZE);
+    EXPECT_EQ(samples.data[1], 1);
+    device.releaseStreamData();
+  }
+  EXPECT_THROW(device.waitForData(), std::runtime_error);
+  device.stopStream();
+  device.stopStream();
+}
+
+TEST_F(ReplaySdrDeviceTest, SampleRateMismatch) {
+  ReplaySdrDevice device(m_config, "replay");
+  EXPECT_THROW(device.readData({FREQUENCY - SAMPLE_RATE, FREQUENCY + SAMPLE_RATE, 2 * SAMPLE_RATE, 2048}), std::runtime_error);
+}
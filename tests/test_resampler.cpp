@@ -0,0 +1,109 @@
+#include <algorithms/resampler.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+constexpr Frequency RESAMPLER_SAMPLE_RATE = 2400000;
+constexpr Frequency RESAMPLER_OUTPUT_RATE = 64000;
+constexpr uint32_t RESAMPLER_DECIMATION = 37;
+constexpr uint32_t RESAMPLER_INPUT_SAMPLES = 20000;
+constexpr uint32_t RESAMPLER_SETTLE_SAMPLES = 100;
+
+// frequency relative to the input rate
+std::vector<std::complex<float>> resamplerTone(double frequency, uint32_t size) {
+  std::vector<std::complex<float>> samples(size);
+  for (uint32_t i = 0; i < size; ++i) {
+    samples[i] = std::complex<float>(std::polar(1.0, 2.0 * M_PI * std::fmod(frequency * i, 1.0)));
+  }
+  return samples;
+}
+
+std::vector<std::complex<float>> resampleChunks(Resampler& resampler, const std::vector<std::complex<float>>& input, uint32_t chunk) {
+  std::vector<std::complex<float>> output;
+  for (uint32_t offset = 0; offset < input.size(); offset += chunk) {
+    const auto size = std::min<uint32_t>(chunk, input.size() - offset);
+    std::vector<std::complex<float>> buffer(resampler.maxOutputSize(size));
+    buffer.resize(resampler.resample(input.data() + offset, size, buffer.data()));
+    output.insert(output.end(), buffer.begin(), buffer.end());
+  }
+  return output;
+}
+
+TEST(ResamplerTest, Ratio) {
+  const auto ratio = resamplingRatio(RESAMPLER_SAMPLE_RATE, RESAMPLER_DECIMATION, RESAMPLER_OUTPUT_RATE);
+  EXPECT_EQ(ratio.interpolation, 74);
+  EXPECT_EQ(ratio.decimation, 75);
+  const auto exact = resamplingRatio(2048000, 32, RESAMPLER_OUTPUT_RATE);
+  EXPECT_EQ(exact.interpolation, exact.decimation);
+}
+
+TEST(ResamplerTest, ExactOutputRate) {
+  for (const auto& ratio : {ResamplingRatio{74, 75}, ResamplingRatio{159, 160}, ResamplingRatio{3, 2}, ResamplingRatio{199773, 200000}}) {
+    Resampler resampler(ratio);
+    const auto output = resampleChunks(resampler, resamplerTone(0.0, RESAMPLER_INPUT_SAMPLES), 1000);
+    const auto expected = (static_cast<uint64_t>(RESAMPLER_INPUT_SAMPLES) * ratio.interpolation + ratio.decimation - 1) / ratio.decimation;
+    EXPECT_EQ(output.size(), expected);
+  }
+}
+
+// a tone keeps its absolute frequency, so its phase step at the output rate follows the exact ratio
+TEST(ResamplerTest, ToneKeepsFrequency) {
+  const ResamplingRatio ratio{74, 75};
+  for (const auto frequency : {0.0, 0.05, -0.2, 0.3}) {
+    Resampler resampler(ratio);
+    const auto output = resampleChunks(resampler, resamplerTone(frequency, RESAMPLER_INPUT_SAMPLES), RESAMPLER_INPUT_SAMPLES);
+    const auto step = std::polar(1.0f, static_cast<float>(2.0 * M_PI * frequency * ratio.decimation / ratio.interpolation));
+    for (uint32_t i = RESAMPLER_SETTLE_SAMPLES; i + 1 < output.size(); ++i) {
+      ASSERT_NEAR(std::abs(output[i]), 1.0f, 0.01f) << frequency;
+      ASSERT_NEAR(std::abs(output[i + 1] - output[i] * step), 0.0f, 0.01f) << frequency;
+    }
+  }
+}
+
+// 44100 from 20 MS/s reduces to 199773 / 200000, its phases are capped and interpolated
+TEST(ResamplerTest, LargeRatio) {
+  const auto ratio = resamplingRatio(20000000, 453, 44100);
+  EXPECT_EQ(ratio.interpolation, 199773);
+  EXPECT_EQ(ratio.decimation, 200000);
+  const auto start = std::chrono::steady_clock::now();
+  const auto filter = resamplerFilter(ratio);
+  EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(100));
+  EXPECT_LE(filter->taps.size(), 65536);
+  for (const auto frequency : {0.0, 0.05, -0.2, 0.3}) {
+    Resampler resampler(ratio, filter);
+    const auto output = resampleChunks(resampler, resamplerTone(frequency, RESAMPLER_INPUT_SAMPLES), 1000);
+    const auto step = std::polar(1.0f, static_cast<float>(2.0 * M_PI * frequency * ratio.decimation / ratio.interpolation));
+    for (uint32_t i = RESAMPLER_SETTLE_SAMPLES; i + 1 < output.size(); ++i) {
+      ASSERT_NEAR(std::abs(output[i]), 1.0f, 0.01f) << frequency;
+      ASSERT_NEAR(std::abs(output[i + 1] - output[i] * step), 0.0f, 0.01f) << frequency;
+    }
+  }
+}
+
+TEST(ResamplerTest, ChunksMatchSingleCall) {
+  const auto input = resamplerTone(0.13, RESAMPLER_INPUT_SAMPLES);
+  Resampler single({74, 75});
+  const auto expected = resampleChunks(single, input, RESAMPLER_INPUT_SAMPLES);
+  Resampler chunked({74, 75});
+  const auto output = resampleChunks(chunked, input, 777);
+  ASSERT_EQ(output.size(), expected.size());
+  for (uint32_t i = 0; i < output.size(); ++i) {
+    ASSERT_NEAR(std::abs(output[i] - expected[i]), 0.0f, 1e-5f) << i;
+  }
+}
+
+TEST(ResamplerTest, ResetMatchesNewResampler) {
+  const auto input = resamplerTone(0.13, RESAMPLER_INPUT_SAMPLES);
+  Resampler fresh({74, 75});
+  const auto expected = resampleChunks(fresh, input, 777);
+  Resampler reused({74, 75});
+  resampleChunks(reused, resamplerTone(0.07, 1001), 333);
+  reused.reset();
+  const auto output = resampleChunks(reused, input, 777);
+  ASSERT_EQ(output.size(), expected.size());
+  for (uint32_t i = 0; i < output.size(); ++i) {
+    ASSERT_EQ(output[i], expected[i]) << i;
+  }
+}
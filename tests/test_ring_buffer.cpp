@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
 #include <ring_buffer.h>
+#include <unistd.h>
+
+#include <thread>
 
 TEST(RingBufferTest, Empty) {
   RingBuffer buffer(100);
@@ -33,7 +36,8 @@ TEST(RingBufferTest, Overflow) {
   }
   EXPECT_EQ(buffer.availableSpaceSize(), SIZE - 1);
   buffer.push(tmp.data(), tmp.size());
-  EXPECT_EQ(buffer.availableDataSize(), 0);
+  EXPECT_EQ(buffer.availableDataSize(), (ITERATION - 1) * SIZE);
+  EXPECT_EQ(buffer.droppedDataSize(), SIZE);
 }
 
 TEST(RingBufferTest, Round) {
@@ -63,3 +67,133 @@ TEST(RingBufferTest, Round) {
 
   EXPECT_EQ(push, popped);
 }
+
+TEST(RingBufferTest, Spans) {
+  constexpr auto BUFFER_SIZE = 100;
+  constexpr auto SIZE = 60;
+
+  std::vector<uint8_t> push(SIZE);
+  for (int i = 0; i < SIZE; ++i) {
+    push[i] = i;
+  }
+
+  RingBuffer buffer(BUFFER_SIZE);
+  buffer.push(push.data(), push.size());
+  const auto first = buffer.peek(SIZE);
+  EXPECT_EQ(first.first.size, SIZE);
+  EXPECT_EQ(first.second.size, 0);
+  EXPECT_EQ(std::vector<uint8_t>(first.first.data, first.first.data + first.first.size), push);
+  buffer.release(SIZE);
+  EXPECT_EQ(buffer.availableDataSize(), 0);
+
+  buffer.push(push.data(), push.size());
+  const auto second = buffer.peek(SIZE);
+  EXPECT_EQ(second.first.size, BUFFER_SIZE - SIZE);
+  EXPECT_EQ(second.second.size, 2 * SIZE - BUFFER_SIZE);
+  std::vector<uint8_t> popped(second.first.data, second.first.data + second.first.size);
+  std::copy(second.second.data, second.second.data + second.second.size, std::back_inserter(popped));
+  EXPECT_EQ(popped, push);
+  EXPECT_EQ(buffer.availableDataSize(), SIZE);
+  buffer.release(SIZE);
+  EXPECT_EQ(buffer.availableDataSize(), 0);
+  EXPECT_THROW(buffer.peek(1), std::runtime_error);
+}
+
+TEST(RingBufferTest, Threads) {
+  constexpr auto PUSH_SIZE = 1229;
+  constexpr auto POP_SIZE = 1231;
+  constexpr auto COUNT = 10000;
+
+  RingBuffer buffer(POP_SIZE * 7);
+  std::thread producer([&buffer]() {
+    std::vector<uint8_t> push(PUSH_SIZE);
+    uint8_t value = 0;
+    for (int i = 0; i < COUNT; ++i) {
+      while (buffer.availableSpaceSize() < PUSH_SIZE) {
+        std::this_thread::yield();
+      }
+      for (auto& v : push) {
+        v = value++;
+      }
+      buffer.push(push.data(), push.size());
+    }
+  });
+
+  uint8_t expected = 0;
+  bool ok = true;
+  for (int i = 0; i < COUNT * PUSH_SIZE / POP_SIZE; ++i) {
+    while (buffer.availableDataSize() < POP_SIZE) {
+      std::this_thread::yield();
+    }
+    const auto spans = buffer.peek(POP_SIZE);
+    for (const auto& span : {spans.first, spans.second}) {
+      for (uint32_t j = 0; j < span.size; ++j) {
+        ok &= span.data[j] == expected++;
+      }
+    }
+    buffer.release(POP_SIZE);
+  }
+  producer.join();
+
+  EXPECT_TRUE(ok);
+  EXPECT_EQ(buffer.droppedDataSize(), 0);
+}
+
+TEST(RingBufferTest, MirroredSize) {
+  const uint32_t pageSize = sysconf(_SC_PAGE_SIZE);
+
+  RingBuffer buffer(pageSize + 1, true);
+  EXPECT_TRUE(buffer.isMirrored());
+  EXPECT_EQ(buffer.bufferSize(), 2 * pageSize);
+  EXPECT_EQ(buffer.availableSpaceSize(), 2 * pageSize);
+}
+
+TEST(RingBufferTest, MirroredContiguous) {
+  const uint32_t pageSize = sysconf(_SC_PAGE_SIZE);
+  const uint32_t size = pageSize + pageSize / 2;
+
+  std::vector<uint8_t> push(size);
+  for (uint32_t i = 0; i < size; ++i) {
+    push[i] = rand();
+  }
+
+  RingBuffer buffer(2 * pageSize, true);
+  for (int i = 0; i < 5; ++i) {
+    buffer.push(push.data(), push.size());
+    const auto spans = buffer.peek(size);
+    EXPECT_EQ(spans.first.size, size);
+    EXPECT_EQ(spans.second.size, 0);
+    EXPECT_EQ(std::vector<uint8_t>(spans.first.data, spans.first.data + spans.first.size), push);
+    buffer.release(size);
+  }
+}
+
+TEST(RingBufferTest, MirroredRound) {
+  std::vector<uint8_t> push;
+  std::vector<uint8_t> popped;
+
+  constexpr auto PUSH_SIZE = 1229;
+  constexpr auto POP_SIZE = 1231;
+  const uint32_t pageSize = sysconf(_SC_PAGE_SIZE);
+
+  for (int i = 0; i < 100 * PUSH_SIZE * POP_SIZE; ++i) {
+    push.push_back(rand());
+  }
+
+  RingBuffer buffer(pageSize, true);
+  uint32_t pushed = 0;
+  while (popped.size() < push.size()) {
+    while (buffer.availableDataSize() < POP_SIZE && pushed < push.size()) {
+      buffer.push(push.data() + pushed, PUSH_SIZE);
+      pushed += PUSH_SIZE;
+    }
+    while (POP_SIZE <= buffer.availableDataSize()) {
+      const auto spans = buffer.peek(POP_SIZE);
+      EXPECT_EQ(spans.second.size, 0);
+      std::copy(spans.first.data, spans.first.data + spans.first.size, std::back_inserter(popped));
+      buffer.release(POP_SIZE);
+    }
+  }
+
+  EXPECT_EQ(push, popped);
+}
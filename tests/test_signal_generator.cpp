@@ -0,0 +1,52 @@
+#include <algorithms/signal_generator.h>
+#include <gtest/gtest.h>
+#include <utils.h>
+
+constexpr Frequency FREQUENCY = 100000000;
+constexpr Frequency SAMPLE_RATE = 1024000;
+constexpr uint32_t SIZE = 2 * 102400;
+
+const FrequencyRange RANGE{FREQUENCY - SAMPLE_RATE / 2, FREQUENCY + SAMPLE_RATE / 2, SAMPLE_RATE, 1024};
+
+float carrierPower(const std::vector<uint8_t>& data, uint32_t first, uint32_t count, double offset) {
+  std::vector<std::complex<float>> samples(data.size() / 2);
+  toComplex(data.data(), samples.data(), data.size());
+  std::complex<double> sum(0.0, 0.0);
+  for (uint32_t i = first; i < first + count; ++i) {
+    sum += std::complex<double>(samples[i]) * std::polar(1.0, -2.0 * M_PI * offset * i / SAMPLE_RATE);
+  }
+  return 20.0 * std::log10(std::abs(sum) / count);
+}
+
+TEST(SignalGeneratorTest, Carrier) {
+  Config config("", R"({"devices": {"generator": {"noise": -60, "transmissions": [{"frequency": 100100000, "power": -10}]}}})");
+  SignalGenerator generator(config);
+  std::vector<uint8_t> data(SIZE);
+  generator.generate(RANGE, std::chrono::microseconds(0), data.data(), data.size());
+  EXPECT_NEAR(carrierPower(data, 0, SIZE / 2, 100000), -10.0f, 0.5f);
+  EXPECT_LT(carrierPower(data, 0, SIZE / 2, 200000), -40.0f);
+}
+
+TEST(SignalGeneratorTest, Burst) {
+  Config config("", R"({"devices": {"generator": {"noise": -60, "transmissions": [{"frequency": 100100000, "power": -10, "period_ms": 100, "duty_cycle": 0.5}]}}})");
+  SignalGenerator generator(config);
+  std::vector<uint8_t> data(SIZE);
+  generator.generate(RANGE, std::chrono::microseconds(0), data.data(), data.size());
+  EXPECT_NEAR(carrierPower(data, 0, SIZE / 4, 100000), -10.0f, 0.5f);
+  EXPECT_LT(carrierPower(data, SIZE / 4, SIZE / 4, 100000), -40.0f);
+}
+
+TEST(SignalGeneratorTest, Continuous) {
+  const auto json = R"({"devices": {"generator": {"seed": 7, "transmissions": [{"frequency": 100012345, "modulation": "fm", "count": 3, "spacing": 25000}]}}})";
+  Config config("", json);
+  SignalGenerator first(config);
+  SignalGenerator second(config);
+  std::vector<uint8_t> whole(SIZE);
+  std::vector<uint8_t> parts(SIZE);
+  first.generate(RANGE, std::chrono::microseconds(0), whole.data(), SIZE);
+  second.generate(RANGE, std::chrono::microseconds(0), parts.data(), SIZE / 2);
+  second.generate(RANGE, std::chrono::microseconds(50000), parts.data() + SIZE / 2, SIZE / 2);
+  for (uint32_t i = 0; i < SIZE; ++i) {
+    ASSERT_NEAR(whole[i], parts[i], 1);
+  }
+}
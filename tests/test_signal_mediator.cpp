@@ -1,12 +1,12 @@
 #include <algorithms/signal_mediator.h>
 #include <gtest/gtest.h>
 
-std::vector<Signal> genSignals(const Frequency& start, const Frequency& stop, const Frequency& step, const Power power) {
-  std::vector<Signal> signals;
-  for (Frequency f = start; f <= stop; f += step) {
-    signals.push_back({f, power});
+Spectrum genSpectrum(const Frequency& start, const Frequency& stop, const Frequency& step, const Power power) {
+  Spectrum spectrum({start, stop, stop - start, (stop - start) / step});
+  for (uint32_t i = 0; i < spectrum.size(); ++i) {
+    spectrum[i] = power;
   }
-  return signals;
+  return spectrum;
 }
 
 void test(
@@ -21,11 +21,12 @@ void test(
   SignalMediator sm(aggTime);
   for (std::chrono::milliseconds t{0}; t < duration; t += stepTime) {
     const auto power = static_cast<Power>(-(t.count() % 100));
-    const auto result = sm.append(startTime + t, genSignals(start, stop, step, power));
+    const auto result = sm.append(startTime + t, genSpectrum(start, stop, step, power));
     if (t % aggTime != std::chrono::milliseconds(0) || t == std::chrono::milliseconds(0)) {
-      EXPECT_EQ(result.size(), 0);
+      EXPECT_FALSE(result.has_value());
     } else {
-      EXPECT_EQ(result.size(), signalsSize);
+      ASSERT_TRUE(result.has_value());
+      EXPECT_EQ(result->size(), signalsSize);
     }
   }
 }
@@ -0,0 +1,68 @@
+#include <algorithms/spectrogram.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+
+constexpr Frequency FREQUENCY = 100000000;
+constexpr Frequency SAMPLE_RATE = 1024000;
+constexpr uint32_t FFT = 1024;
+constexpr uint32_t SAMPLES = 65536;
+constexpr Frequency TONE = 100000;
+
+class SpectrogramTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    m_data.resize(2 * SAMPLES);
+    for (uint32_t i = 0; i < SAMPLES; ++i) {
+      const auto phase = 2.0 * M_PI * TONE * i / SAMPLE_RATE;
+      m_data[2 * i] = std::lround(127.5 + 100.0 * std::cos(phase));
+      m_data[2 * i + 1] = std::lround(127.5 + 100.0 * std::sin(phase));
+    }
+  }
+
+  Frequency peak(const Spectrum& spectrum) { return spectrum.frequency(std::max_element(spectrum.data(), spectrum.data() + spectrum.size()) - spectrum.data()); }
+
+  const Config m_config{"", "{}"};
+  const FrequencyRange m_range{FREQUENCY - SAMPLE_RATE / 2, FREQUENCY + SAMPLE_RATE / 2, SAMPLE_RATE, FFT};
+  std::vector<uint8_t> m_data;
+};
+
+TEST_F(SpectrogramTest, TonePeak) {
+  Spectrogram spectrogram(m_config);
+  const auto spectrum = spectrogram.psd(m_range, m_data.data(), SAMPLES, SampleFormat::CU8, 0);
+  EXPECT_EQ(peak(spectrum), FREQUENCY + TONE);
+}
+
+TEST_F(SpectrogramTest, RawMatchesComplex) {
+  Spectrogram spectrogram(m_config);
+  std::vector<std::complex<float>> samples(SAMPLES);
+  toComplex(m_data.data(), samples.data(), m_data.size());
+  const auto raw = spectrogram.psd(m_range, m_data.data(), SAMPLES, SampleFormat::CU8, 0);
+  const auto complex = spectrogram.psd(m_range, samples.data(), SAMPLES);
+  ASSERT_EQ(raw.size(), complex.size());
+  for (uint32_t i = 0; i < raw.size(); ++i) {
+    EXPECT_NEAR(raw[i], complex[i], 1e-3);
+  }
+}
+
+TEST_F(SpectrogramTest, FrequencyOffset) {
+  Spectrogram spectrogram(m_config);
+  const auto spectrum = spectrogram.psd(m_range, m_data.data(), SAMPLES, SampleFormat::CU8, -static_cast<int32_t>(TONE));
+  EXPECT_EQ(peak(spectrum), FREQUENCY);
+}
+
+TEST_F(SpectrogramTest, BudgetCoversShortBurst) {
+  for (uint32_t i = 0; i < SAMPLES; ++i) {
+    if (i < 40000 || 42000 <= i) {
+      m_data[2 * i] = 128;
+      m_data[2 * i + 1] = 128;
+    }
+  }
+  const Config sparseConfig("", R"({"detection": {"welch_budget": 0.05}})");
+  Spectrogram sparse(sparseConfig);
+  EXPECT_EQ(peak(sparse.psd(m_range, m_data.data(), SAMPLES, SampleFormat::CU8, 0)), FREQUENCY);
+  const Config denseConfig("", R"({"detection": {"welch_budget": 1.0, "welch_max_overlap": 0.5}})");
+  Spectrogram dense(denseConfig);
+  EXPECT_EQ(peak(dense.psd(m_range, m_data.data(), SAMPLES, SampleFormat::CU8, 0)), FREQUENCY + TONE);
+}
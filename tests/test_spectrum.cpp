@@ -0,0 +1,50 @@
+#include <gtest/gtest.h>
+#include <radio/help_structures.h>
+
+#include <vector>
+
+// frequencies the spectrogram produced per bin before powers were stored without them
+std::vector<Frequency> binFrequencies(const FrequencyRange& range) {
+  std::vector<Frequency> frequencies;
+  const auto origin = range.center() - range.sampleRate / 2;
+  for (uint32_t i = 0; i < range.fft; ++i) {
+    const auto frequency = origin + static_cast<uint64_t>(i) * range.sampleRate / range.fft;
+    if (range.start <= frequency && frequency <= range.stop) {
+      frequencies.push_back(frequency);
+    }
+  }
+  if (frequencies.back() != range.stop) {
+    frequencies.push_back(range.stop);
+  }
+  return frequencies;
+}
+
+TEST(SpectrumTest, Frequencies) {
+  for (const FrequencyRange range : {
+           FrequencyRange(99000000, 101000000, 2000000, 2000),
+           FrequencyRange(99000000, 101000000, 2048000, 1024),
+           FrequencyRange(99100000, 100900000, 2048000, 1000),
+           FrequencyRange(144000000, 146000000, 2000000, 1023),
+       }) {
+    const auto expected = binFrequencies(range);
+    const Spectrum spectrum(range);
+    ASSERT_EQ(spectrum.size(), expected.size()) << range.toString();
+    for (uint32_t i = 0; i < spectrum.size(); ++i) {
+      ASSERT_EQ(spectrum.frequency(i), expected[i]) << range.toString();
+      EXPECT_EQ(spectrum[i], 0.0f);
+    }
+  }
+}
+
+TEST(SpectrumTest, LowerBound) {
+  const Spectrum spectrum({99100000, 100900000, 2048000, 1000});
+  EXPECT_EQ(spectrum.lowerBound(0), 0);
+  EXPECT_EQ(spectrum.lowerBound(100900001), spectrum.size());
+  for (Frequency frequency = 99100000; frequency <= 100900000; frequency += 777) {
+    const auto index = spectrum.lowerBound(frequency);
+    ASSERT_LE(frequency, spectrum.frequency(index));
+    if (0 < index) {
+      ASSERT_LT(spectrum.frequency(index - 1), frequency);
+    }
+  }
+}
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include <radio/settle_estimator.h>
+#include <radio/sweep_scheduler.h>
+
+#include <random>
+
+TEST(SweepSchedulerTest, Order) {
+  const Config config("", "");
+  const std::vector<FrequencyRange> ranges{
+      {148000000, 150000000, 2048000, 2048},
+      {430000000, 440000000, 10240000, 2048},
+      {144000000, 146000000, 2048000, 2048},
+      {420000000, 430000000, 10240000, 2048},
+      {146000000, 148000000, 2048000, 2048},
+  };
+  SweepScheduler scheduler(config, ranges);
+  EXPECT_EQ(scheduler.size(), 5);
+  const std::vector<Frequency> forward{144000000, 146000000, 148000000, 420000000, 430000000};
+  for (const auto start : forward) {
+    EXPECT_EQ(scheduler.next().start, start);
+  }
+  for (auto it = forward.rbegin(); it != forward.rend(); ++it) {
+    EXPECT_EQ(scheduler.next().start, *it);
+  }
+  EXPECT_EQ(scheduler.next().start, forward.front());
+}
+
+TEST(SweepSchedulerTest, Activity) {
+  const Config config("", R"({"detection": {"sweep_mode": "activity", "max_revisit_interval_ms": 900}})");
+  std::vector<FrequencyRange> ranges;
+  for (Frequency i = 0; i < 5; ++i) {
+    ranges.emplace_back(144000000 + i * 2000000, 146000000 + i * 2000000, 2048000, 2048);
+  }
+  SweepScheduler scheduler(config, ranges);
+  constexpr auto MAX_REVISIT = 9;
+  constexpr auto SLOTS = 1000;
+
+  std::vector<uint32_t> visits(ranges.size(), 0);
+  std::vector<int> lastVisit{-5, -4, -3, -2, -1};
+  for (int slot = 0; slot < SLOTS; ++slot) {
+    const auto range = scheduler.next();
+    const auto index = (range.start - 144000000) / 2000000;
+    EXPECT_LE(slot - lastVisit[index], MAX_REVISIT);
+    lastVisit[index] = slot;
+    visits[index]++;
+    scheduler.report(range, index == 2);
+  }
+  for (uint32_t i = 0; i < ranges.size(); ++i) {
+    EXPECT_LE(SLOTS - lastVisit[i], MAX_REVISIT);
+    if (i != 2) {
+      EXPECT_GT(visits[2], 3 * visits[i]);
+    }
+  }
+}
+
+TEST(SweepSchedulerTest, ActivityDefaultRevisit) {
+  const Config config("", R"({"detection": {"sweep_mode": "activity"}})");
+  std::vector<FrequencyRange> ranges;
+  for (Frequency i = 0; i < 5; ++i) {
+    ranges.emplace_back(144000000 + i * 2000000, 146000000 + i * 2000000, 2048000, 2048);
+  }
+  SweepScheduler scheduler(config, ranges);
+
+  std::vector<int> lastVisit{-5, -4, -3, -2, -1};
+  for (int slot = 0; slot < 100; ++slot) {
+    const auto range = scheduler.next();
+    const auto index = (range.start - 144000000) / 2000000;
+    EXPECT_LE(slot - lastVisit[index], 5);
+    lastVisit[index] = slot;
+    scheduler.report(range, index == 2);
+  }
+}
+
+TEST(SweepSchedulerTest, InvalidMode) { EXPECT_THROW(Config("", R"({"detection": {"sweep_mode": "activty"}})"), std::runtime_error); }
+
+TEST(SettleEstimatorTest, Measure) {
+  constexpr uint32_t SIZE = 65536;
+  constexpr uint32_t UNSETTLED = 8192;
+  std::mt19937 random(0);
+  std::normal_distribution<float> noise(127.5f, 10.0f);
+  std::vector<uint8_t> data(SIZE);
+  for (uint32_t i = 0; i < SIZE; ++i) {
+    data[i] = i < UNSETTLED ? 127 : static_cast<uint8_t>(std::clamp(noise(random), 0.0f, 255.0f));
+  }
+
+  SettleEstimator estimator("Settle", 32768);
+  EXPECT_EQ(estimator.update(data.data(), data.size()), UNSETTLED);
+  EXPECT_GE(estimator.size(), UNSETTLED);
+  EXPECT_LE(estimator.size(), 32768);
+
+  for (uint32_t i = 0; i < UNSETTLED; ++i) {
+    data[i] = static_cast<uint8_t>(std::clamp(noise(random), 0.0f, 255.0f));
+  }
+  EXPECT_EQ(estimator.update(data.data(), data.size()), 0);
+}
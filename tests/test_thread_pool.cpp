@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+#include <thread_pool.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+TEST(ThreadPoolTest, ExecuteAll) {
+  constexpr auto COUNT = 10000;
+  std::atomic_uint32_t counter(0);
+  {
+    ThreadPool pool("ThreadPool", 4);
+    EXPECT_EQ(pool.threadsCount(), 4);
+    for (int i = 0; i < COUNT; ++i) {
+      pool.submit([&counter]() { counter++; });
+    }
+  }
+  EXPECT_EQ(counter, COUNT);
+}
+
+TEST(ThreadPoolTest, StealNestedTasks) {
+  constexpr auto COUNT = 64;
+  std::atomic_uint32_t counter(0);
+  ThreadPool pool("ThreadPool", 4);
+  pool.submit([&pool, &counter]() {
+    for (int i = 0; i < COUNT; ++i) {
+      pool.submit([&counter]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        counter++;
+      });
+    }
+  });
+  while (counter < COUNT) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  const auto statistics = pool.statistics();
+  ASSERT_EQ(statistics.size(), 4);
+  uint64_t executed = 0;
+  uint64_t stolen = 0;
+  uint32_t maxDepth = 0;
+  for (const auto& queue : statistics) {
+    EXPECT_EQ(queue.depth, 0);
+    executed += queue.executed;
+    stolen += queue.stolen;
+    maxDepth = std::max(maxDepth, queue.maxDepth);
+  }
+  EXPECT_EQ(executed, COUNT + 1);
+  EXPECT_LT(0, stolen);
+  EXPECT_LT(1, maxDepth);
+}
+
+TEST(ThreadPoolTest, TaskException) {
+  std::atomic_uint32_t counter(0);
+  {
+    ThreadPool pool("ThreadPool", 1);
+    pool.submit([]() { throw std::runtime_error("task failed"); });
+    pool.submit([&counter]() { counter++; });
+  }
+  EXPECT_EQ(counter, 1);
+}